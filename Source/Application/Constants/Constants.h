@@ -28,6 +28,13 @@ extern float TIME_SCALE;
 #define MAX_POINT_LIGHTS               16
 #define MAX_SPOT_LIGHTS                8
 
+/*===========================================================
+    UNIFORM BLOCK BINDING POINTS
+===========================================================*/
+#define DIRECTIONAL_LIGHT_BINDING      0
+#define POINT_LIGHT_BINDING            1
+#define CAMERA_BINDING                 2
+
 /*===========================================================
     STAR: SUN4
 ===========================================================*/
@@ -12,10 +12,17 @@
 #include <Application/Core/Engine/Engine.h>
 #include <Application/Core/Services/Input/InputDispatcher.h>
 #include <Application/Core/Services/Managers/SceneManager/SceneManager.h>
+#include <Application/Core/Services/Editor/Editor.h>
 
 #include <Application/Utils/SpaceUtils/SpaceUtils.h>
 #include <Application/Utils/ImGUIUtils/ImGUIUtils.h>
-#include <Application/Core/Physics/Physics.h>
+#include <Application/Core/Physics/PhysicsSystem.h>
+#include <Application/Core/Renderer/RenderSystem.h>
+#include <Application/Core/Services/CameraService/CameraFollowSystem.h>
+#include <Application/Core/Services/CameraService/CameraUpdateSystem.h>
+#include <Application/Core/Services/Lighting/LightGatherSystem.h>
+#include <Application/Core/Services/Transform/TransformSystem.h>
+#include <Application/Core/Services/Rewind/RewindSystem.h>
 
 #include <Application/Constants/Constants.h>
 
@@ -26,7 +33,7 @@ namespace Nyx {
     {
         // Create texture
         glGenTextures(1, &m_sceneColorTex);
-        glBindTexture(GL_TEXTURE_2D, m_sceneColorTex);
+        GLStateCache::Get().BindTexture(0, m_sceneColorTex);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_sceneTexWidth, m_sceneTexHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -56,26 +63,52 @@ namespace Nyx {
         m_sceneTexWidth = newSize.x;
         m_sceneTexHeight = newSize.y;
 
-        Camera& camera = *ECS::Get().GetComponent<Camera>(scenePtr->GetActiveCameraID());
+        Camera& camera = *scenePtr->GetWorld().GetComponent<Camera>(scenePtr->GetActiveCameraID());
         camera.SetAspectRatio((float32)m_sceneTexWidth / (float32)m_sceneTexHeight);
 
         glDeleteFramebuffers(1, &m_sceneFBO);
+        GLStateCache::Get().ForgetTexture(m_sceneColorTex);
         glDeleteTextures(1, &m_sceneColorTex);
         glDeleteRenderbuffers(1, &m_sceneDepthRBO);
     
         InitFBO(); // Recreate with new size
     }
 
+    void Engine::RegisterSystems()
+    {
+        // Registration order is the execution order between systems that conflict
+        m_scheduler.Register<PhysicsSystem>();
+        m_scheduler.Register<RewindSystem>();
+        m_scheduler.Register<TransformSystem>();
+        m_scheduler.Register<CameraFollowSystem>();
+        m_scheduler.Register<CameraUpdateSystem>();
+        m_scheduler.Register<LightGatherSystem>();
+        m_scheduler.Register<RenderSystem>(m_Renderer);
+    }
+
     void Engine::Present(Scene& scene)
     {
         glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFBO);
 
         glViewport(0, 0, m_sceneTexWidth, m_sceneTexHeight);
+        m_Renderer.SetViewportHeight(static_cast<float32>(m_sceneTexHeight));
+        // The clear obeys the depth mask, which the last draw may have left off
+        GLStateCache::Get().ResetStats();
+        GLStateCache::Get().SetDepthMask(true);
+
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        Physics::Update(DELTA_TIME);
-        m_Renderer.DrawScene(scene);
+        ECS& world = scene.GetWorld();
+        Editor::Get().activeWorld = &world;
+
+        // Structural changes recorded by systems are applied once everything has run
+        world.BeginDeferred();
+        m_scheduler.Run(SystemContext{ &scene, &world, DELTA_TIME });
+        world.EndDeferred();
+
+        // Anything touched after this point counts as a change for the next frame
+        world.AdvanceTick();
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
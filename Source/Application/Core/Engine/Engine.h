@@ -6,6 +6,7 @@
 #include <Application/Utils/ShaderUtils/ShaderUtils.h>
 
 #include <Application/Core/Renderer/Renderer.h>
+#include <Application/Core/Services/Scheduler/SystemScheduler.h>
 
 namespace Nyx 
 {
@@ -16,19 +17,23 @@ namespace Nyx
 			this->m_windowPtr = static_cast<GLFWwindow*>(windowPtr);
 
 			InitFBO();
+			RegisterSystems();
 		}
 
 		void InitFBO();
 		void ResizeFBO(Math::Vec2f newSize, Scene* scenePtr);
 		void Present(Scene& scene);
+		void RegisterSystems();
 
 		GLuint GetSceneFBO() const { return m_sceneFBO; }
 		GLuint GetSceneColorTex() const { return m_sceneColorTex; }
 		GLuint GetSceneDepthRBO() const { return m_sceneDepthRBO; }
 		Renderer& GetRenderer() { return m_Renderer; }
+		SystemScheduler& GetScheduler() { return m_scheduler; }
 
 	private:
 		Renderer m_Renderer;
+		SystemScheduler m_scheduler;
 
 		GLuint m_sceneFBO = 0;
 		GLuint m_sceneColorTex = 0;
@@ -9,7 +9,7 @@
 namespace Physics
 {
     // Apply angular velocity to a transform quaternion
-    void IntegrateAngularVelocity(Transform& tr, Rigidbody& rb, float dt)
+    inline void IntegrateAngularVelocity(Transform& tr, Rigidbody& rb, float dt)
     {
         Math::Vec3f w = rb.angularVelocity.GetWorld();
         float wlen = glm::length(w);
@@ -21,12 +21,12 @@ namespace Physics
         }
     }
 
-    void Iterate(const EntityID& objID, float deltaTime)
+    inline void Iterate(ECS& world, const EntityID& objID, float deltaTime)
     {
         const float dt = deltaTime * TIME_SCALE;
 
-        Transform& transform = *ECS::Get().GetComponent<Transform>(objID);
-        Rigidbody& rigidbody = *ECS::Get().GetComponent<Rigidbody>(objID);
+        Transform& transform = *world.GetComponent<Transform>(objID);
+        Rigidbody& rigidbody = *world.GetComponent<Rigidbody>(objID);
 
         Position& pos = transform.position;
         Velocity& vel = rigidbody.velocity;
@@ -38,18 +38,20 @@ namespace Physics
         IntegrateAngularVelocity(transform, rigidbody, dt);
     }
 
-	void Update(float deltaTime)
+	inline void Update(ECS& world, float deltaTime)
 	{
-        const auto& sphereIDs = ECS::Get().GetAllComponentIDs<Sphere>();
+        // Paused: nothing would move, so leave transforms unstamped
+        if (TIME_SCALE == 0.0f)
+            return;
 
-        for (size_t i = 0; i < sphereIDs.size(); ++i)
+        // Every rigidbody is simulated, drawn or not; a world loaded without graphics has no spheres.
+        // A world may not have any bodies yet; View copes with missing pools.
+        for (EntityID id : world.View<Transform, Rigidbody>())
         {
-            const EntityID& id = sphereIDs[i];
-            if (!ECS::Get().HasComponent<Transform>(id) || !ECS::Get().HasComponent<Rigidbody>(id))
-                continue;
+            if (!world.HasComponent<Massless>(id))
+                Attract(world, id);
 
-            Attract(id);
-            Iterate(id, deltaTime);
+            Iterate(world, id, deltaTime);
         }
 	}
 }
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <Application/Core/Physics/Physics.h>
+#include <Application/Core/Services/Scheduler/System.h>
+
+namespace Nyx
+{
+	class PhysicsSystem : public ISystem
+	{
+	public:
+		const char8* GetName() const override { return "Physics"; }
+
+		void DeclareAccess(SystemAccess& access) const override
+		{
+			access.Reads<TidallyLocked, Massless>().Writes<Transform, Rigidbody>();
+		}
+
+		void Update(const SystemContext& context) override
+		{
+			Physics::Update(*context.world, context.deltaTime);
+		}
+	};
+}
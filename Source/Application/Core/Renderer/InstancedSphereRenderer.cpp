@@ -0,0 +1,256 @@
+#include "InstancedSphereRenderer.h"
+
+#include <algorithm>
+
+#include <Application/Utils/MeshUtils/MeshBuilder.h>
+
+namespace Nyx
+{
+	namespace
+	{
+		constexpr GLuint MODEL_LOCATION = 3; // four columns, 3 to 6
+		constexpr GLuint BASE_COLOR_LOCATION = 7;
+		constexpr GLuint EMISSIVE_LOCATION = 8;
+
+		// GL 3.3 has no base instance, so each batch re-points the attributes at its slice
+		void PointInstanceAttributes(usize firstInstance)
+		{
+			const usize base = firstInstance * sizeof(SphereInstance);
+			const GLsizei stride = sizeof(SphereInstance);
+
+			for (GLuint column = 0; column < 4; ++column)
+			{
+				glVertexAttribPointer(MODEL_LOCATION + column, 4, GL_FLOAT, GL_FALSE, stride,
+					(void*)(base + offsetof(SphereInstance, model) + column * sizeof(Math::Vec4f)));
+			}
+
+			glVertexAttribPointer(BASE_COLOR_LOCATION, 4, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(SphereInstance, baseColor)));
+			glVertexAttribPointer(EMISSIVE_LOCATION, 3, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(SphereInstance, emissiveColor)));
+		}
+
+		void EnableInstanceAttributes()
+		{
+			for (GLuint location = MODEL_LOCATION; location <= EMISSIVE_LOCATION; ++location)
+			{
+				glEnableVertexAttribArray(location);
+				glVertexAttribDivisor(location, 1);
+			}
+		}
+
+		SphereInstance MakeInstance(const DrawPacket& packet)
+		{
+			const Material& material = packet.sphere->m_material;
+			return SphereInstance{ packet.model, Math::Vec4f(material.GetBaseColor(), material.GetEmissiveStrength()), material.GetEmissiveColor() };
+		}
+	}
+
+	InstancedSphereRenderer::~InstancedSphereRenderer()
+	{
+		GLStateCache& state = GLStateCache::Get();
+
+		for (auto& [resolution, mesh] : m_unitMeshes)
+		{
+			state.ForgetVertexArray(mesh.instanced.vao.m_data);
+			glDeleteVertexArrays(1, &mesh.instanced.vao.m_data);
+		}
+
+		if (m_impostorMesh.shared != nullptr)
+		{
+			state.ForgetVertexArray(m_impostorMesh.instanced.vao.m_data);
+			glDeleteVertexArrays(1, &m_impostorMesh.instanced.vao.m_data);
+		}
+
+		if (m_pointVAO != 0)
+		{
+			state.ForgetVertexArray(m_pointVAO);
+			glDeleteVertexArrays(1, &m_pointVAO);
+		}
+
+		if (m_instanceBuffer != 0)
+			glDeleteBuffers(1, &m_instanceBuffer);
+	}
+
+	void InstancedSphereRenderer::Draw(const Vector<DrawPacket>& packets, const RenderQueue& queue)
+	{
+		BuildBatches(packets, queue, true);
+		if (m_batches.empty())
+			return;
+
+		if (m_shader.GetID() == NO_ID)
+		{
+			m_shader = ResourceManager::GetShader(
+				"SphereInstancedShader",
+				R"(Nyx\Source\Application\Shaders\Sphere\sphere_instanced.vert)",
+				R"(Nyx\Source\Application\Shaders\Sphere\sphere_instanced.frag)"
+			);
+		}
+
+		Upload();
+		DrawBatches(m_shader, false);
+	}
+
+	void InstancedSphereRenderer::DrawImpostors(const Vector<DrawPacket>& packets, const RenderQueue& queue)
+	{
+		BuildBatches(packets, queue, false);
+		if (m_batches.empty())
+			return;
+
+		if (m_impostorShader.GetID() == NO_ID)
+		{
+			m_impostorShader = ResourceManager::GetShader(
+				"SphereImpostorShader",
+				R"(Nyx\Source\Application\Shaders\Sphere\sphere_impostor.vert)",
+				R"(Nyx\Source\Application\Shaders\Sphere\sphere_impostor.frag)"
+			);
+		}
+
+		Upload();
+		DrawBatches(m_impostorShader, true);
+	}
+
+	void InstancedSphereRenderer::DrawPoints(const Vector<DrawPacket>& packets, float32 pointSize)
+	{
+		if (packets.empty())
+			return;
+
+		if (m_pointShader.GetID() == NO_ID)
+		{
+			m_pointShader = ResourceManager::GetShader(
+				"SpherePointShader",
+				R"(Nyx\Source\Application\Shaders\Sphere\sphere_point.vert)",
+				R"(Nyx\Source\Application\Shaders\Sphere\sphere_point.frag)"
+			);
+		}
+
+		m_instances.clear();
+		m_instances.reserve(packets.size());
+		for (const DrawPacket& packet : packets)
+			m_instances.push_back(MakeInstance(packet));
+
+		Upload();
+
+		if (m_pointVAO == 0)
+		{
+			glGenVertexArrays(1, &m_pointVAO);
+			GLStateCache::Get().BindVertexArray(m_pointVAO);
+			glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+			EnableInstanceAttributes();
+			GLStateCache::Get().BindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+
+		m_pointShader.Use();
+
+		ImmediatePipeline::Get().UseSphere();
+		glPointSize(pointSize);
+
+		GLStateCache::Get().BindVertexArray(m_pointVAO);
+		glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+		PointInstanceAttributes(0);
+		glDrawArraysInstanced(GL_POINTS, 0, 1, static_cast<GLsizei>(m_instances.size()));
+	}
+
+	void InstancedSphereRenderer::DrawBatches(const Shader& shader, bool8 impostors)
+	{
+		shader.Use();
+		shader.SetInt("uTexture", 0);
+
+		ImmediatePipeline::Get().UseSphere();
+
+		for (const Batch& batch : m_batches)
+		{
+			const Mesh& mesh = impostors ? GetImpostorMesh() : GetUnitMesh(batch.resolution);
+
+			GLStateCache::Get().BindVertexArray(mesh.vao.m_data);
+			glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+			PointInstanceAttributes(batch.first);
+
+			shader.SetBool("uHasTexture", batch.texture != 0);
+			if (batch.texture != 0)
+				GLStateCache::Get().BindTexture(0, batch.texture);
+
+			glDrawElementsInstanced(GL_TRIANGLES, mesh.ebo.m_indexCount, GL_UNSIGNED_INT, 0, batch.count);
+		}
+	}
+
+	void InstancedSphereRenderer::BuildBatches(const Vector<DrawPacket>& packets, const RenderQueue& queue, bool8 byResolution)
+	{
+		m_instances.clear();
+		m_batches.clear();
+
+		m_instances.reserve(queue.GetSize());
+		for (const RenderQueue::Item& item : queue.GetItems())
+		{
+			const DrawPacket& packet = packets[item.index];
+			const Texture* texture = packet.sphere->m_material.GetTexture();
+
+			uint32 resolution = byResolution ? packet.resolution : 0;
+			uint32 textureID = texture != nullptr ? texture->GetID() : 0;
+
+			if (m_batches.empty() || m_batches.back().resolution != resolution || m_batches.back().texture != textureID)
+				m_batches.push_back(Batch{ resolution, textureID, static_cast<uint32>(m_instances.size()), 0 });
+
+			m_instances.push_back(MakeInstance(packet));
+			++m_batches.back().count;
+		}
+	}
+
+	void InstancedSphereRenderer::Upload()
+	{
+		if (m_instanceBuffer == 0)
+			glGenBuffers(1, &m_instanceBuffer);
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+
+		// Grow geometrically; otherwise orphan the old storage so the driver need not wait on last frame's draws
+		if (m_instances.size() > m_capacity)
+			m_capacity = std::max(m_instances.size(), m_capacity * 2);
+
+		glBufferData(GL_ARRAY_BUFFER, m_capacity * sizeof(SphereInstance), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, m_instances.size() * sizeof(SphereInstance), m_instances.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	InstancedSphereRenderer::UnitMesh InstancedSphereRenderer::CreateUnitMesh(MeshKind kind, uint32 resolution)
+	{
+		UnitMesh unit;
+		unit.shared = ResourceManager::GetMesh(kind, resolution);
+		unit.instanced = *unit.shared;
+
+		// The vertex and index buffers are shared; only the attribute setup is ours
+		glGenVertexArrays(1, &unit.instanced.vao.m_data);
+		GLStateCache::Get().BindVertexArray(unit.instanced.vao.m_data);
+
+		glBindBuffer(GL_ARRAY_BUFFER, unit.shared->vbo.m_data);
+		if (kind == MeshKind::QUAD)
+			MeshBuilder::SetQuadVertexLayout();
+		else
+			MeshBuilder::SetSphereVertexLayout();
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, unit.shared->ebo.m_data);
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+		EnableInstanceAttributes();
+
+		GLStateCache::Get().BindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		return unit;
+	}
+
+	const Mesh& InstancedSphereRenderer::GetUnitMesh(uint32 resolution)
+	{
+		auto it = m_unitMeshes.find(resolution);
+		if (it != m_unitMeshes.end())
+			return it->second.instanced;
+
+		return m_unitMeshes.emplace(resolution, CreateUnitMesh(MeshKind::SPHERE, resolution)).first->second.instanced;
+	}
+
+	const Mesh& InstancedSphereRenderer::GetImpostorMesh()
+	{
+		if (m_impostorMesh.shared == nullptr)
+			m_impostorMesh = CreateUnitMesh(MeshKind::QUAD, 0);
+
+		return m_impostorMesh.instanced;
+	}
+}
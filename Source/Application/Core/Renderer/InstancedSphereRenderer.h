@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Application/Core/Renderer/RenderExtraction.h>
+#include <Application/Core/Renderer/RenderQueue.h>
+#include <Application/Resource/Components/Mesh/Mesh.h>
+
+namespace Nyx
+{
+	// Per-instance attributes, laid out to match sphere_instanced.vert
+	struct SphereInstance
+	{
+		Math::Mat4f model;
+		Math::Vec4f baseColor;     // rgb color, a emissive strength
+		Math::Vec3f emissiveColor;
+	};
+
+	// Draws spheres in batches that share a texture and mesh resolution: one unit sphere
+	// per resolution, one instance buffer for the whole frame, and one glDrawElementsInstanced
+	// per run of matching items in the sorted render queue. Material parameters other than the texture travel per instance, so
+	// differently coloured bodies still batch together.
+	//
+	// DrawImpostors uses the same instances but draws each sphere as a camera-facing quad that
+	// sphere_impostor.frag ray-casts, giving exact silhouettes and depth for four vertices a body.
+	class InstancedSphereRenderer
+	{
+	public:
+		InstancedSphereRenderer() = default;
+		~InstancedSphereRenderer();
+
+		InstancedSphereRenderer(const InstancedSphereRenderer&) = delete;
+		InstancedSphereRenderer& operator=(const InstancedSphereRenderer&) = delete;
+
+		// `queue` holds the packets sorted for submission; see Renderer::BuildQueue
+		void Draw(const Vector<DrawPacket>& packets, const RenderQueue& queue);
+		void DrawImpostors(const Vector<DrawPacket>& packets, const RenderQueue& queue);
+
+		// One unlit point per sphere at its center, in a single draw call
+		void DrawPoints(const Vector<DrawPacket>& packets, float32 pointSize);
+
+		uint32 GetDrawCalls() const { return static_cast<uint32>(m_batches.size()); }
+		uint32 GetInstanceCount() const { return static_cast<uint32>(m_instances.size()); }
+
+	private:
+		struct Batch
+		{
+			uint32 resolution;
+			uint32 texture;
+			uint32 first;
+			uint32 count;
+		};
+
+		// Impostors batch by texture alone, so they pass byResolution = false
+		void BuildBatches(const Vector<DrawPacket>& packets, const RenderQueue& queue, bool8 byResolution);
+		void Upload();
+		void DrawBatches(const Shader& shader, bool8 impostors);
+
+		struct UnitMesh
+		{
+			SharedPtr<const Mesh> shared;
+			Mesh instanced;
+		};
+
+		// Own VAO over the shared buffers, with the instance attributes attached
+		UnitMesh CreateUnitMesh(MeshKind kind, uint32 resolution);
+		const Mesh& GetUnitMesh(uint32 resolution);
+		const Mesh& GetImpostorMesh();
+
+		Shader m_shader;
+		Shader m_impostorShader;
+		Shader m_pointShader;
+		HashMap<uint32, UnitMesh> m_unitMeshes;
+		UnitMesh m_impostorMesh;
+		uint32 m_pointVAO = 0; // instance attributes only
+
+		uint32 m_instanceBuffer = 0;
+		usize m_capacity = 0; // in instances
+
+		Vector<SphereInstance> m_instances;
+		Vector<Batch> m_batches;
+	};
+}
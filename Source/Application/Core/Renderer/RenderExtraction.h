@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Application/Constants/Constants.h>
+#include <Application/Core/Services/Managers/EntityManager/EntityManager.h>
+#include <Application/Core/Services/Transform/TransformHierarchy.h>
+#include <Application/Resource/Components/Components.h>
+#include <Application/Resource/Components/Mesh/Mesh.h>
+
+namespace Nyx
+{
+	// Everything the renderer needs for one sphere, with the model matrix already camera-relative
+	struct DrawPacket
+	{
+		Math::Mat4f model;
+		const Sphere* sphere;
+		EntityID entity;
+
+		// The sphere's own mesh unless a level of detail was selected for this frame
+		const Mesh* mesh;
+		uint32 resolution;
+	};
+
+	// Walks the Sphere pool once per frame and writes a dense packet array, so drawing is a
+	// linear pass with no per-entity lookups. World matrices come from the world's TransformHierarchy,
+	// which only recomputes the ones whose transforms changed.
+	class RenderExtractor
+	{
+	public:
+		Vector<DrawPacket>& Extract(ECS& world, const Transform& cameraTransform)
+		{
+			m_packets.clear();
+
+			if (world.GetComponentCount<Sphere>() == 0)
+				return m_packets;
+
+			const TransformHierarchy& hierarchy = world.GetResource<TransformHierarchy>();
+			const Vector<EntityID>& ids = world.GetAllComponentIDs<Sphere>();
+			const Vector<Sphere>& spheres = world.ReadAllComponents<Sphere>();
+
+			m_packets.reserve(ids.size());
+
+			const Math::Vec3f cameraPos = cameraTransform.position.GetWorld();
+			const float32 toRenderUnits = static_cast<float32>(1.0 / METERS_PER_UNIT);
+
+			for (usize i = 0; i < ids.size(); ++i)
+			{
+				if (!hierarchy.Contains(ids[i]))
+					continue;
+
+				// Scale it down for rendering purposes and move the origin to the camera
+				const Math::Mat4f& worldMatrix = hierarchy.GetWorldMatrix(ids[i]);
+				Math::Mat4f model = worldMatrix;
+				model[0] *= toRenderUnits;
+				model[1] *= toRenderUnits;
+				model[2] *= toRenderUnits;
+				model[3] = Math::Vec4f(Math::Vec3f(worldMatrix[3]) * toRenderUnits - cameraPos, 1.0f);
+
+				const Sphere& sphere = spheres[i];
+				m_packets.push_back(DrawPacket{ model, &sphere, ids[i], sphere.m_sphereMesh.get(), sphere.m_resolution });
+			}
+
+			return m_packets;
+		}
+
+		const Vector<DrawPacket>& GetPackets() const { return m_packets; }
+
+	private:
+		Vector<DrawPacket> m_packets;
+	};
+}
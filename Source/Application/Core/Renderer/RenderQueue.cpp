@@ -0,0 +1,74 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Nyx
+{
+	namespace
+	{
+		constexpr uint32 DEPTH_BITS = 26;
+		constexpr uint32 TEXTURE_BITS = 16;
+		constexpr uint32 MESH_BITS = 10;
+		constexpr uint32 SHADER_BITS = 10;
+
+		constexpr uint32 TEXTURE_SHIFT = DEPTH_BITS;
+		constexpr uint32 MESH_SHIFT = TEXTURE_SHIFT + TEXTURE_BITS;
+		constexpr uint32 SHADER_SHIFT = MESH_SHIFT + MESH_BITS;
+		constexpr uint32 PASS_SHIFT = SHADER_SHIFT + SHADER_BITS;
+
+		constexpr uint64 Mask(uint32 bits) { return (uint64(1) << bits) - 1; }
+	}
+
+	uint64 RenderQueue::MakeKey(RenderPass pass, uint32 shader, uint32 mesh, uint32 texture, float32 depth, float32 nearPlane, float32 farPlane)
+	{
+		// Logarithmic, so the bits are spread evenly from the near plane out to planetary distances.
+		// In double, since float32 can't hold the 26-bit maximum and the far plane would wrap to 0.
+		float64 clamped = std::clamp(float64(depth), float64(nearPlane), float64(farPlane));
+		float64 normalized = std::log(clamped / nearPlane) / std::log(float64(farPlane) / nearPlane);
+		uint64 quantized = std::min(static_cast<uint64>(normalized * float64(Mask(DEPTH_BITS))), Mask(DEPTH_BITS));
+
+		if (pass == RenderPass::BLENDED)
+			quantized = Mask(DEPTH_BITS) - quantized;
+
+		return (uint64(pass) << PASS_SHIFT)
+			| ((shader & Mask(SHADER_BITS)) << SHADER_SHIFT)
+			| ((mesh & Mask(MESH_BITS)) << MESH_SHIFT)
+			| ((texture & Mask(TEXTURE_BITS)) << TEXTURE_SHIFT)
+			| (quantized & Mask(DEPTH_BITS));
+	}
+
+	void RenderQueue::Sort()
+	{
+		const usize count = m_items.size();
+		if (count < 2)
+			return;
+
+		m_scratch.resize(count);
+
+		for (uint32 shift = 0; shift < 64; shift += 8)
+		{
+			usize offsets[256] = {};
+			for (const Item& item : m_items)
+				++offsets[(item.key >> shift) & 0xFF];
+
+			// Every key has the same byte here, so this pass wouldn't move anything
+			if (offsets[(m_items[0].key >> shift) & 0xFF] == count)
+				continue;
+
+			usize total = 0;
+			for (usize& offset : offsets)
+			{
+				usize bucket = offset;
+				offset = total;
+				total += bucket;
+			}
+
+			// Stable scatter, so earlier passes' order survives within a bucket
+			for (const Item& item : m_items)
+				m_scratch[offsets[(item.key >> shift) & 0xFF]++] = item;
+
+			m_items.swap(m_scratch);
+		}
+	}
+}
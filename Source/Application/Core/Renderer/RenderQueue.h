@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+
+namespace Nyx
+{
+	enum class RenderPass : uint32
+	{
+		SOLID,
+		BLENDED
+	};
+
+	// Draw items ordered by a 64-bit key, most significant field first:
+	//
+	//   63..62 pass | 61..52 shader | 51..42 mesh | 41..26 texture | 25..0 depth
+	//
+	// so walking the sorted items changes the shader least often, then the mesh, then the
+	// texture. Solid depth sorts front to back to help early depth rejection; blended
+	// depth is inverted so it sorts back to front. Fields wider than their bits are masked,
+	// which can only cost batching, never correctness: submission compares real state.
+	class RenderQueue
+	{
+	public:
+		struct Item
+		{
+			uint64 key;
+			uint32 index; // into whatever array the caller keyed
+		};
+
+		// Depth is the view distance; near and far are the camera's planes
+		static uint64 MakeKey(RenderPass pass, uint32 shader, uint32 mesh, uint32 texture, float32 depth, float32 nearPlane, float32 farPlane);
+
+		void Clear() { m_items.clear(); }
+		void Push(uint64 key, uint32 index) { m_items.push_back(Item{ key, index }); }
+
+		// LSD radix sort, one byte per pass; bytes every key shares are skipped
+		void Sort();
+
+		const Vector<Item>& GetItems() const { return m_items; }
+		usize GetSize() const { return m_items.size(); }
+
+	private:
+		Vector<Item> m_items;
+		Vector<Item> m_scratch;
+	};
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Application/Core/Renderer/Renderer.h>
+#include <Application/Core/Services/Scheduler/System.h>
+
+namespace Nyx
+{
+	class RenderSystem : public ISystem
+	{
+	public:
+		RenderSystem(Renderer& renderer) : m_renderer(renderer) {}
+
+		const char8* GetName() const override { return "Render"; }
+
+		void DeclareAccess(SystemAccess& access) const override
+		{
+			access.Reads<Transform, Camera, Sphere, LightComponent, LightingSystem, TransformHierarchy>().RunOnMainThread();
+		}
+
+		void Update(const SystemContext& context) override
+		{
+			m_renderer.DrawScene(*context.scene);
+		}
+
+	private:
+		Renderer& m_renderer;
+	};
+}
@@ -8,8 +8,13 @@
 #include <Application/Core/Physics/Meter.h>
 #include <Application/Core/Services/Managers/EntityManager/EntityManager.h>
 #include <Application/Core/Services/Managers/SceneManager/SceneManager.h>
+#include <Application/Core/Renderer/RenderExtraction.h>
+#include <Application/Core/Renderer/InstancedSphereRenderer.h>
+#include <Application/Core/Renderer/SphereLOD.h>
+#include <Application/Core/Renderer/SphereCuller.h>
 #include <Application/Resource/Material/ShaderProgram/ShaderProgram.h>
 #include <Application/Core/Services/Lighting/LightingSystem.h>
+#include <Application/Core/Services/CameraService/CameraUniforms.h>
 #include <Application/Resource/Components/Components.h>
 
 
@@ -19,6 +24,10 @@ namespace Nyx
 	{
 	public:
         bool m_gridEnabled = true;
+        bool m_instancingEnabled = true;
+        bool m_lodEnabled = true;
+        bool m_impostorsEnabled = false;
+        bool m_cullingEnabled = true;
 
         Renderer()
         {
@@ -27,25 +36,121 @@ namespace Nyx
 
         void DrawScene(Scene& scene)
         {
-            const Camera& camera = *ECS::Get().GetComponent<Camera>(scene.GetActiveCameraID());
-            const Transform& transform = *ECS::Get().GetComponent<Transform>(scene.GetActiveCameraID());
+            ECS& world = scene.GetWorld();
+
+            const Camera& camera = *world.ReadComponent<Camera>(scene.GetActiveCameraID());
+            const Transform& transform = *world.ReadComponent<Transform>(scene.GetActiveCameraID());
+
+            // Shared by every shader through the uniform blocks, so nothing below uploads them per draw
+            CameraUniforms::Get().Upload(camera);
+            LightingSystem::Get().UploadBuffers();
 
             if (m_gridEnabled)
             {
-                m_grid.DrawGrid(camera, transform);
+                m_grid.DrawGrid(transform);
             }
 
-            LightingSystem::Get().GatherLights(transform);
+            const Math::Mat4f& view = camera.GetViewMatrix();
+            const Math::Mat4f& projection = camera.GetProjectionMatrix();
+
+            Vector<DrawPacket>& packets = m_extractor.Extract(world, transform);
+            m_extractedSpheres = static_cast<uint32>(packets.size());
+
+            if (m_cullingEnabled)
+                m_culler.Cull(packets, view, projection, m_viewportHeight);
 
-            for (size_t i = 0; i < scene.GetSceneObjectSize(); ++i)
+            DrawSpheres(packets, camera, projection);
+
+            // Sub-pixel spheres the culler kept as points
+            if (m_cullingEnabled && !m_culler.GetPoints().empty())
             {
-                const auto& object = scene.GetSceneObject(i);
-                object->Draw(camera, transform);
+                m_instanced.DrawPoints(m_culler.GetPoints(), 2.0f * m_culler.m_minPixelRadius);
+                m_sphereDrawCalls += 1;
+                m_sphereVertices += m_culler.GetPoints().size();
             }
         }
 
+        uint32 GetSphereCount() const { return m_extractedSpheres; }
+        uint32 GetMeshSphereCount() const { return static_cast<uint32>(m_extractor.GetPackets().size()); }
+        uint32 GetSphereDrawCalls() const { return m_sphereDrawCalls; }
+        uint64 GetSphereVertexCount() const { return m_sphereVertices; }
+        SphereLOD& GetSphereLOD() { return m_lod; }
+        SphereCuller& GetSphereCuller() { return m_culler; }
+
+        void SetViewportHeight(float32 height) { m_viewportHeight = height; }
+
     private:
+        // Every sphere is a solid draw keyed by its shader, mesh and texture, nearest first
+        void BuildQueue(const Vector<DrawPacket>& packets, const Camera& camera, bool8 byMesh)
+        {
+            m_queue.Clear();
+
+            for (uint32 i = 0; i < packets.size(); ++i)
+            {
+                const Material& material = packets[i].sphere->m_material;
+                const Texture* texture = material.GetTexture();
+
+                uint64 key = RenderQueue::MakeKey(RenderPass::SOLID,
+                    material.GetShader().GetID(),
+                    byMesh ? packets[i].resolution : 0,
+                    texture != nullptr ? texture->GetID() : 0,
+                    glm::length(Math::Vec3f(packets[i].model[3])),
+                    camera.GetNearPlane(), camera.GetFarPlane());
+
+                m_queue.Push(key, i);
+            }
+
+            m_queue.Sort();
+        }
+
+        void DrawSpheres(Vector<DrawPacket>& packets, const Camera& camera, const Math::Mat4f& projection)
+        {
+            // Impostors are ray-cast per pixel, so tessellation and LOD don't apply
+            if (m_impostorsEnabled)
+            {
+                BuildQueue(packets, camera, false);
+                m_instanced.DrawImpostors(packets, m_queue);
+                m_sphereDrawCalls = m_instanced.GetDrawCalls();
+                m_sphereVertices = uint64(packets.size()) * 4;
+                return;
+            }
+
+            if (m_lodEnabled)
+                m_lod.Select(packets, projection, m_viewportHeight);
+
+            m_sphereVertices = 0;
+            for (const DrawPacket& packet : packets)
+                m_sphereVertices += uint64(packet.resolution + 1) * (packet.resolution + 1);
+
+            BuildQueue(packets, camera, true);
+
+            if (m_instancingEnabled)
+            {
+                m_instanced.Draw(packets, m_queue);
+                m_sphereDrawCalls = m_instanced.GetDrawCalls();
+                return;
+            }
+
+            // Binds that repeat between neighbours are skipped by GLStateCache and the uniform cache
+            for (const RenderQueue::Item& item : m_queue.GetItems())
+            {
+                const DrawPacket& packet = packets[item.index];
+                packet.sphere->DrawSphere(*packet.mesh, packet.model);
+            }
+
+            m_sphereDrawCalls = static_cast<uint32>(packets.size());
+        }
+
         GridMesh m_grid;
+        RenderExtractor m_extractor;
+        InstancedSphereRenderer m_instanced;
+        SphereLOD m_lod;
+        SphereCuller m_culler;
+        RenderQueue m_queue;
+        uint32 m_extractedSpheres = 0;
+        uint32 m_sphereDrawCalls = 0;
+        uint64 m_sphereVertices = 0;
+        float32 m_viewportHeight = 720.0f;
 
 	};
 }
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "SphereCuller.h"
+
+#include <algorithm>
+
+namespace Nyx
+{
+	void SphereCuller::Cull(Vector<DrawPacket>& packets, const Math::Mat4f& view, const Math::Mat4f& projection, float32 viewportHeight)
+	{
+		const usize count = packets.size();
+
+		m_points.clear();
+		m_culled = 0;
+
+		m_x.resize(count);
+		m_y.resize(count);
+		m_z.resize(count);
+		m_radius.resize(count);
+		m_visible.assign(count, 1);
+		m_large.resize(count);
+
+		for (usize i = 0; i < count; ++i)
+		{
+			const Math::Mat4f& model = packets[i].model;
+			m_x[i] = model[3].x;
+			m_y[i] = model[3].y;
+			m_z[i] = model[3].z;
+			m_radius[i] = std::max({ glm::length(Math::Vec3f(model[0])),
+									 glm::length(Math::Vec3f(model[1])),
+									 glm::length(Math::Vec3f(model[2])) });
+		}
+
+		// Frustum planes from the rows of the view-projection (Gribb and Hartmann), normalized
+		// so the plane distance can be compared against the radius
+		const Math::Mat4f clip = projection * view;
+		const Math::Vec4f rows[4] = {
+			Math::Vec4f(clip[0][0], clip[1][0], clip[2][0], clip[3][0]),
+			Math::Vec4f(clip[0][1], clip[1][1], clip[2][1], clip[3][1]),
+			Math::Vec4f(clip[0][2], clip[1][2], clip[2][2], clip[3][2]),
+			Math::Vec4f(clip[0][3], clip[1][3], clip[2][3], clip[3][3]),
+		};
+
+		Math::Vec4f planes[6] = {
+			rows[3] + rows[0], rows[3] - rows[0], // left, right
+			rows[3] + rows[1], rows[3] - rows[1], // bottom, top
+			rows[3] + rows[2], rows[3] - rows[2], // near, far
+		};
+
+		const float32* x = m_x.data();
+		const float32* y = m_y.data();
+		const float32* z = m_z.data();
+		const float32* radius = m_radius.data();
+		uint8* visible = m_visible.data();
+		uint8* large = m_large.data();
+
+		for (Math::Vec4f& plane : planes)
+		{
+			plane = plane / glm::length(Math::Vec3f(plane));
+
+			const float32 a = plane.x, b = plane.y, c = plane.z, d = plane.w;
+			for (usize i = 0; i < count; ++i)
+				visible[i] &= static_cast<uint8>(a * x[i] + b * y[i] + c * z[i] + d >= -radius[i]);
+		}
+
+		// Projected radius r f / sqrt(d^2 - r^2) against the threshold, squared to stay branch-free;
+		// a camera inside the sphere makes the right side negative, which counts as large
+		const float32 focal = projection[1][1] * viewportHeight * 0.5f;
+		const float32 minRadius = m_minPixelRadius / focal;
+		const float32 minRadiusSquared = minRadius * minRadius;
+
+		for (usize i = 0; i < count; ++i)
+		{
+			float32 r2 = radius[i] * radius[i];
+			float32 d2 = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+			large[i] = static_cast<uint8>(r2 >= minRadiusSquared * (d2 - r2));
+		}
+
+		usize kept = 0;
+		for (usize i = 0; i < count; ++i)
+		{
+			if (!visible[i])
+				++m_culled;
+			else if (!large[i])
+				m_points.push_back(packets[i]);
+			else
+				packets[kept++] = packets[i];
+		}
+
+		packets.resize(kept);
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Application/Core/Renderer/RenderExtraction.h>
+
+namespace Nyx
+{
+	// Removes spheres the camera can't see before anything is submitted. Bounding spheres come
+	// from the model matrices, so they include Transform::scale and any parent scale. Spheres
+	// entirely outside one of the six frustum planes are dropped. Visible ones whose projected
+	// radius is below m_minPixelRadius are moved to a point list, so distant planets stay
+	// visible as a dot without paying for a mesh.
+	//
+	// The tests run over structure-of-arrays copies of the centers and radii, in branch-free
+	// loops the compiler can vectorize across bodies.
+	class SphereCuller
+	{
+	public:
+		float32 m_minPixelRadius = 1.0f;
+
+		// Compacts `packets` to the spheres that should be drawn as geometry
+		void Cull(Vector<DrawPacket>& packets, const Math::Mat4f& view, const Math::Mat4f& projection, float32 viewportHeight);
+
+		const Vector<DrawPacket>& GetPoints() const { return m_points; }
+		uint32 GetCulledCount() const { return m_culled; }
+
+	private:
+		Vector<float32> m_x, m_y, m_z, m_radius;
+		Vector<uint8> m_visible;
+		Vector<uint8> m_large;
+
+		Vector<DrawPacket> m_points;
+		uint32 m_culled = 0;
+	};
+}
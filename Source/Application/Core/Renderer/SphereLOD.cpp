@@ -0,0 +1,74 @@
+#include "SphereLOD.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <glm/gtc/constants.hpp>
+
+namespace Nyx
+{
+	void SphereLOD::Select(Vector<DrawPacket>& packets, const Math::Mat4f& projection, float32 viewportHeight)
+	{
+		if (m_meshes[0] == nullptr)
+		{
+			for (uint32 level = 0; level < LEVEL_COUNT; ++level)
+				m_meshes[level] = ResourceManager::GetMesh(MeshKind::SPHERE, RESOLUTIONS[level]);
+		}
+
+		std::fill(std::begin(m_levelCounts), std::end(m_levelCounts), 0u);
+
+		// Pixels covered by a tangent of one at the center of the view
+		const float32 focal = projection[1][1] * viewportHeight * 0.5f;
+
+		for (DrawPacket& packet : packets)
+		{
+			// The unit mesh is scaled by the model matrix, which is already camera-relative
+			float32 radius = std::max({ glm::length(Math::Vec3f(packet.model[0])),
+										glm::length(Math::Vec3f(packet.model[1])),
+										glm::length(Math::Vec3f(packet.model[2])) });
+			float32 distance = glm::length(Math::Vec3f(packet.model[3]));
+
+			// Tangent of the angular radius, so bodies seen up close are not underestimated
+			float32 projectedRadius = distance > radius
+				? focal * radius / std::sqrt(distance * distance - radius * radius)
+				: std::numeric_limits<float32>::max();
+
+			uint8 level = PickLevel(packet.entity, projectedRadius);
+			++m_levelCounts[level];
+
+			packet.mesh = m_meshes[level].get();
+			packet.resolution = RESOLUTIONS[level];
+		}
+	}
+
+	uint8 SphereLOD::PickLevel(EntityID id, float32 projectedRadius)
+	{
+		if (id >= m_levels.size())
+			m_levels.resize(id + 1, UNSET);
+
+		uint32 level = m_levels[id];
+
+		if (level == UNSET)
+		{
+			level = 0;
+			while (level + 1 < LEVEL_COUNT && projectedRadius > MaxRadius(level))
+				++level;
+		}
+		else
+		{
+			while (level + 1 < LEVEL_COUNT && projectedRadius > MaxRadius(level) * (1.0f + m_hysteresis))
+				++level;
+			while (level > 0 && projectedRadius < MaxRadius(level - 1) * (1.0f - m_hysteresis))
+				--level;
+		}
+
+		m_levels[id] = static_cast<uint8>(level);
+		return m_levels[id];
+	}
+
+	float32 SphereLOD::MaxRadius(uint32 level) const
+	{
+		// A ring of n segments around a sphere of radius r has edges of about 2 pi r / n pixels
+		return RESOLUTIONS[level] * m_pixelsPerSegment / glm::two_pi<float32>();
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Application/Core/Renderer/RenderExtraction.h>
+
+namespace Nyx
+{
+	// Picks a tessellation level per sphere each frame from its projected radius in pixels,
+	// so vertex work follows screen coverage instead of the authored resolution. A level is
+	// good enough while its edges stay below m_pixelsPerSegment on screen; switching away from
+	// the current level needs a margin past the threshold, so bodies hovering at a boundary
+	// don't pop back and forth.
+	class SphereLOD
+	{
+	public:
+		static constexpr uint32 LEVEL_COUNT = 7;
+		static constexpr uint32 RESOLUTIONS[LEVEL_COUNT] = { 4, 8, 16, 32, 64, 128, 256 };
+
+		float32 m_pixelsPerSegment = 4.0f;
+		float32 m_hysteresis = 0.2f; // fraction of the threshold
+
+		// Rewrites the mesh and resolution of every packet; the projection is the camera's
+		void Select(Vector<DrawPacket>& packets, const Math::Mat4f& projection, float32 viewportHeight);
+
+		uint32 GetLevelCount(uint32 level) const { return m_levelCounts[level]; }
+
+	private:
+		static constexpr uint8 UNSET = 0xFF;
+
+		uint8 PickLevel(EntityID id, float32 projectedRadius);
+		float32 MaxRadius(uint32 level) const;
+
+		SharedPtr<const Mesh> m_meshes[LEVEL_COUNT];
+		Vector<uint8> m_levels; // indexed by entity, level used last frame
+
+		uint32 m_levelCounts[LEVEL_COUNT] = {};
+	};
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+#include <Application/Core/Services/CameraService/CameraService.h>
+#include <Application/Core/Services/Managers/SceneManager/SceneManager.h>
+#include <Application/Core/Services/Scheduler/System.h>
+
+namespace Nyx
+{
+	// Moves the active camera around the tracked entity when follow mode is enabled
+	class CameraFollowSystem : public ISystem
+	{
+	public:
+		const char8* GetName() const override { return "Camera Follow"; }
+
+		void DeclareAccess(SystemAccess& access) const override
+		{
+			access.Reads<CameraService>().Writes<Transform, Camera>();
+		}
+
+		void Update(const SystemContext& context) override
+		{
+			const CameraService& service = CameraService::Get();
+			if (!service.enabled)
+				return;
+
+			ECS& world = *context.world;
+
+			EntityID cameraID = context.scene->GetActiveCameraID();
+			if (!world.HasComponent<Transform>(cameraID))
+				return;
+
+			if (!world.HasComponent<Transform>(service.targetEntity))
+				return;
+
+			const Transform& targetTransform = *world.ReadComponent<Transform>(service.targetEntity);
+			const Position& pos = targetTransform.position / METERS_PER_UNIT;
+			Math::Vec3f targetPos = pos.GetWorld();
+
+			// Spherical to Cartesian
+			Math::Vec3f direction;
+			direction.x = cos(glm::radians(service.yaw)) * cos(glm::radians(service.pitch));
+			direction.y = sin(glm::radians(service.pitch));
+			direction.z = sin(glm::radians(service.yaw)) * cos(glm::radians(service.pitch));
+			direction = glm::normalize(direction);
+
+			Math::Vec3f cameraPos = targetPos - direction * service.distance;
+
+			Transform& cameraTransform = *world.GetComponent<Transform>(cameraID);
+			cameraTransform.position.SetWorld(cameraPos);
+
+			Camera& camera = *world.GetComponent<Camera>(cameraID);
+			camera.SetFront(glm::normalize(targetPos - cameraPos));
+			camera.SetRight(glm::normalize(glm::cross(camera.GetFront(), camera.GetWorldUp())));
+			camera.SetUp(glm::cross(camera.GetRight(), camera.GetFront()));
+		}
+	};
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstring>
+
+#include <GL/glew.h>
+
+#include <Application/Core/Core.h>
+#include <Application/Constants/Constants.h>
+#include <Application/Resource/Camera/Camera.h>
+
+namespace Nyx
+{
+	// std140 mirror of CameraBlock in Shaders/Common/camera.glsl
+	struct CameraBlock
+	{
+		CameraMatrices matrices;
+		Math::Vec4f planes; // x near, y far
+	};
+
+	static_assert(sizeof(CameraMatrices) == 6 * sizeof(Math::Mat4f));
+
+	// Publishes the active camera's matrices in one uniform buffer on a fixed binding point,
+	// so shaders read them without per-draw uploads. Needs the GL context.
+	class CameraUniforms : public Singleton<CameraUniforms>
+	{
+	public:
+		void Upload(const Camera& camera)
+		{
+			CameraBlock block{ camera.GetMatrices(), Math::Vec4f(camera.GetNearPlane(), camera.GetFarPlane(), 0.0f, 0.0f) };
+
+			if (m_buffer == 0)
+			{
+				glGenBuffers(1, &m_buffer);
+				glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+				glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlock), nullptr, GL_DYNAMIC_DRAW);
+				glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BINDING, m_buffer);
+			}
+			// Comparing contents rather than a version also catches a switch to another camera
+			else if (std::memcmp(&block, &m_uploaded, sizeof(CameraBlock)) == 0)
+			{
+				return;
+			}
+
+			m_uploaded = block;
+
+			glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+			glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraBlock), &block);
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		}
+
+	private:
+		uint32 m_buffer = 0;
+		CameraBlock m_uploaded{};
+	};
+}
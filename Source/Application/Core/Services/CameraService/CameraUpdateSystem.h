@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+#include <Application/Core/Services/Managers/SceneManager/SceneManager.h>
+#include <Application/Core/Services/Scheduler/System.h>
+#include <Application/Resource/Camera/Camera.h>
+
+namespace Nyx
+{
+	// Brings the active camera's cached matrices up to date once per frame, after everything
+	// that moves the camera and before anything that renders with it
+	class CameraUpdateSystem : public ISystem
+	{
+	public:
+		const char8* GetName() const override { return "Camera Update"; }
+
+		void DeclareAccess(SystemAccess& access) const override
+		{
+			access.Writes<Camera>();
+		}
+
+		void Update(const SystemContext& context) override
+		{
+			ECS& world = *context.world;
+
+			EntityID cameraID = context.scene->GetActiveCameraID();
+			if (!world.HasComponent<Camera>(cameraID))
+				return;
+
+			// Only a camera that changed is written, so unchanged frames don't stamp the pool
+			if (world.ReadComponent<Camera>(cameraID)->IsDirty())
+				world.GetComponent<Camera>(cameraID)->UpdateMatrices();
+		}
+	};
+}
@@ -9,5 +9,8 @@ namespace Nyx
 	{
 	public:
 		Optional<EntityID> selectedEntity;
+
+		// World shown in the game view; input and inspector act on it
+		ECS* activeWorld = nullptr;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,349 @@
+#include "EnsembleRunner.h"
+
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <spdlog/fmt/fmt.h>
+
+#ifdef SPACESIM_WINDOWS
+#include <process.h>
+#else
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <Application/Constants/Constants.h>
+#include <Application/Core/Physics/Physics.h>
+#include <Application/Core/Services/Snapshot/Snapshot.h>
+#include <Application/Resource/Components/Components.h>
+#include <Application/Utils/MathUtils/Random.h>
+
+namespace Nyx
+{
+	bool8 EnsembleDesc::Load(const String& path, EnsembleDesc& desc)
+	{
+		IfStream file(path);
+		if (!file.is_open())
+		{
+			spdlog::error("Could not open ensemble file: {}", path);
+			return false;
+		}
+
+		String line;
+		uint32 lineNumber = 0;
+		while (std::getline(file, line))
+		{
+			++lineNumber;
+
+			usize comment = line.find('#');
+			if (comment != String::npos)
+				line.resize(comment);
+
+			StringStream tokens(line);
+			String key;
+			if (!(tokens >> key))
+				continue;
+
+			bool8 ok = false;
+			if (key == "scene")
+				ok = static_cast<bool8>(tokens >> desc.scene);
+			else if (key == "members")
+				ok = static_cast<bool8>(tokens >> desc.members) && desc.members > 0;
+			else if (key == "workers")
+				ok = static_cast<bool8>(tokens >> desc.workers);
+			else if (key == "seed")
+				ok = static_cast<bool8>(tokens >> desc.seed);
+			else if (key == "frames")
+				ok = static_cast<bool8>(tokens >> desc.frames);
+			else if (key == "timescale")
+				ok = static_cast<bool8>(tokens >> desc.timeScale);
+			else if (key == "position_sigma")
+				ok = static_cast<bool8>(tokens >> desc.positionSigma);
+			else if (key == "velocity_sigma")
+				ok = static_cast<bool8>(tokens >> desc.velocitySigma);
+			else if (key == "mass_sigma")
+				ok = static_cast<bool8>(tokens >> desc.massSigma);
+			else if (key == "output")
+				ok = static_cast<bool8>(tokens >> desc.output);
+
+			if (!ok)
+				spdlog::warn("{}:{}: could not read '{}'", path, lineNumber, key);
+		}
+
+		return true;
+	}
+
+	// The executable and config are only needed to spawn workers where there is no fork
+	bool8 EnsembleRunner::Run(ECS& world, const EnsembleDesc& desc, [[maybe_unused]] const String& executable, [[maybe_unused]] const String& configPath)
+	{
+		uint32 workers = desc.workers > 0 ? desc.workers : std::max(1u, Thread::hardware_concurrency());
+		workers = std::min(workers, desc.members);
+
+		spdlog::info("Running {} ensemble members for {} frames on {} workers", desc.members, desc.frames, workers);
+		auto start = std::chrono::steady_clock::now();
+
+		bool8 ok = true;
+
+#ifdef SPACESIM_WINDOWS
+		// No fork: workers rebuild the scene and restore the parent's state from a snapshot
+		if (!Snapshot::Save(world, SnapshotPath(desc)))
+			return false;
+
+		String quotedConfig = "\"" + configPath + "\"";
+		Vector<intptr_t> handles;
+
+		for (uint32 w = 0; w < workers; ++w)
+		{
+			String spec = fmt::format("{}:{}", w, workers);
+			intptr_t handle = _spawnl(_P_NOWAIT, executable.c_str(), executable.c_str(),
+				"--ensemble", quotedConfig.c_str(), "--ensemble-worker", spec.c_str(), nullptr);
+
+			if (handle == -1)
+			{
+				spdlog::error("Could not spawn ensemble worker {}", w);
+				ok = false;
+				break;
+			}
+
+			handles.push_back(handle);
+		}
+
+		for (intptr_t handle : handles)
+		{
+			int status = 0;
+			ok = _cwait(&status, handle, 0) != -1 && status == 0 && ok;
+		}
+
+		FileSystem::remove(SnapshotPath(desc));
+#else
+		Vector<pid_t> children;
+
+		for (uint32 w = 0; w < workers; ++w)
+		{
+			// The child starts from the loaded scene; pages are only copied once it writes them
+			pid_t pid = fork();
+			if (pid == 0)
+			{
+				// Skip destructors and exit handlers; everything the child inherited belongs to the parent
+				_exit(RunWorker(world, desc, w, workers) ? 0 : 1);
+			}
+
+			if (pid < 0)
+			{
+				spdlog::error("Could not fork ensemble worker {}", w);
+				ok = false;
+				break;
+			}
+
+			children.push_back(pid);
+		}
+
+		for (pid_t pid : children)
+		{
+			int status = 0;
+			ok = waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0 && ok;
+		}
+#endif
+
+		if (ok)
+			ok = WriteSummary(world, desc, workers);
+		else
+			spdlog::error("An ensemble worker failed; no summary written");
+
+		for (uint32 w = 0; w < workers; ++w)
+			FileSystem::remove(PartPath(desc, w));
+
+		if (ok)
+		{
+			float64 seconds = std::chrono::duration<float64>(std::chrono::steady_clock::now() - start).count();
+			spdlog::info("Ensemble finished in {:.2f} s, summary written to {}", seconds, desc.output);
+		}
+
+		return ok;
+	}
+
+	bool8 EnsembleRunner::RunWorkerProcess(ECS& world, const EnsembleDesc& desc, const String& spec)
+	{
+		uint32 worker = 0;
+		uint32 workers = 0;
+		char8 separator = 0;
+
+		StringStream tokens(spec);
+		if (!(tokens >> worker >> separator >> workers) || separator != ':' || worker >= workers)
+		{
+			spdlog::error("Bad ensemble worker spec '{}'", spec);
+			return false;
+		}
+
+		if (!Snapshot::Load(world, SnapshotPath(desc)))
+			return false;
+
+		return RunWorker(world, desc, worker, workers);
+	}
+
+	Vector<EntityID> EnsembleRunner::TrackedBodies(ECS& world)
+	{
+		Vector<EntityID> tracked;
+		for (EntityID id : world.View<Name, Transform, Rigidbody>())
+		{
+			if (!world.HasComponent<Massless>(id))
+				tracked.push_back(id);
+		}
+		return tracked;
+	}
+
+	bool8 EnsembleRunner::RunWorker(ECS& world, const EnsembleDesc& desc, uint32 worker, uint32 workers)
+	{
+		// State every member starts from
+		Vector<EntityID> bodies = world.View<Transform, Rigidbody>();
+		Vector<Transform> baseTransforms;
+		Vector<Rigidbody> baseRigidbodies;
+		baseTransforms.reserve(bodies.size());
+		baseRigidbodies.reserve(bodies.size());
+
+		for (EntityID id : bodies)
+		{
+			baseTransforms.push_back(*world.ReadComponent<Transform>(id));
+			baseRigidbodies.push_back(*world.ReadComponent<Rigidbody>(id));
+		}
+
+		Vector<EntityID> tracked = TrackedBodies(world);
+
+		OfStream out(PartPath(desc, worker), std::ios::binary | std::ios::trunc);
+		if (!out)
+		{
+			spdlog::error("Ensemble worker {} could not open {}", worker, PartPath(desc, worker));
+			return false;
+		}
+
+		TIME_SCALE = desc.timeScale;
+
+		for (uint32 member = worker; member < desc.members; member += workers)
+		{
+			Random random = Random::ForStream(desc.seed, member);
+
+			for (usize i = 0; i < bodies.size(); ++i)
+			{
+				Transform& transform = *world.GetComponent<Transform>(bodies[i]);
+				Rigidbody& rigidbody = *world.GetComponent<Rigidbody>(bodies[i]);
+				transform = baseTransforms[i];
+				rigidbody = baseRigidbodies[i];
+
+				if (member == 0)
+					continue;
+
+				Math::Vec3f positionOffset(
+					static_cast<float32>(random.Normal(0.0, desc.positionSigma)),
+					static_cast<float32>(random.Normal(0.0, desc.positionSigma)),
+					static_cast<float32>(random.Normal(0.0, desc.positionSigma)));
+				Math::Vec3f velocityOffset(
+					static_cast<float32>(random.Normal(0.0, desc.velocitySigma)),
+					static_cast<float32>(random.Normal(0.0, desc.velocitySigma)),
+					static_cast<float32>(random.Normal(0.0, desc.velocitySigma)));
+
+				transform.position.SetWorld(transform.position.GetWorld() + positionOffset);
+				rigidbody.velocity.SetWorld(rigidbody.velocity.GetWorld() + velocityOffset);
+				rigidbody.mass *= std::max(0.0, 1.0 + random.Normal(0.0, desc.massSigma));
+			}
+
+			for (uint64 frame = 0; frame < desc.frames; ++frame)
+				Physics::Update(world, DELTA_TIME);
+
+			out.write(reinterpret_cast<const char8*>(&member), sizeof(member));
+			for (EntityID id : tracked)
+			{
+				BodyState state{ world.ReadComponent<Transform>(id)->position.GetWorld(), world.ReadComponent<Rigidbody>(id)->velocity.GetWorld() };
+				out.write(reinterpret_cast<const char8*>(&state), sizeof(state));
+			}
+		}
+
+		return out.good();
+	}
+
+	bool8 EnsembleRunner::WriteSummary(ECS& world, const EnsembleDesc& desc, uint32 workers)
+	{
+		Vector<EntityID> tracked = TrackedBodies(world);
+		usize stride = tracked.size();
+
+		Vector<BodyState> results(usize(desc.members) * stride);
+		Vector<bool8> received(desc.members, false);
+
+		for (uint32 w = 0; w < workers; ++w)
+		{
+			IfStream in(PartPath(desc, w), std::ios::binary);
+
+			uint32 member = 0;
+			while (in.read(reinterpret_cast<char8*>(&member), sizeof(member)))
+			{
+				if (member >= desc.members
+					|| !in.read(reinterpret_cast<char8*>(results.data() + member * stride), stride * sizeof(BodyState)))
+				{
+					spdlog::error("Ensemble results from worker {} are malformed", w);
+					return false;
+				}
+
+				received[member] = true;
+			}
+		}
+
+		if (std::find(received.begin(), received.end(), false) != received.end())
+		{
+			spdlog::error("Ensemble results are missing members");
+			return false;
+		}
+
+		OfStream out(desc.output, std::ios::trunc);
+		if (!out)
+		{
+			spdlog::error("Could not open {} for the ensemble summary", desc.output);
+			return false;
+		}
+
+		out << fmt::format("# {} members, {} frames at time scale {}, seed {}\n", desc.members, desc.frames, desc.timeScale, desc.seed);
+		out << fmt::format("# sigma: position {} m, velocity {} m/s, mass {}\n", desc.positionSigma, desc.velocitySigma, desc.massSigma);
+		out << "# member 0 is the unperturbed control; positions in meters, speeds in m/s\n";
+		out << "body,mean_x,mean_y,mean_z,std_x,std_y,std_z,spread,control_offset,mean_speed,std_speed\n";
+
+		for (usize b = 0; b < stride; ++b)
+		{
+			// Welford, accumulated in member order so the result is independent of the worker count
+			Math::Vec3d mean(0.0);
+			Math::Vec3d m2(0.0);
+			float64 meanSpeed = 0.0;
+			float64 m2Speed = 0.0;
+
+			for (uint32 m = 0; m < desc.members; ++m)
+			{
+				const BodyState& state = results[m * stride + b];
+				Math::Vec3d position(state.position);
+				float64 speed = glm::length(Math::Vec3d(state.velocity));
+
+				Math::Vec3d delta = position - mean;
+				mean += delta / float64(m + 1);
+				m2 += delta * (position - mean);
+
+				float64 speedDelta = speed - meanSpeed;
+				meanSpeed += speedDelta / float64(m + 1);
+				m2Speed += speedDelta * (speed - meanSpeed);
+			}
+
+			float64 samples = desc.members > 1 ? float64(desc.members - 1) : 1.0;
+			Math::Vec3d variance = m2 / samples;
+			Math::Vec3d sigma(std::sqrt(variance.x), std::sqrt(variance.y), std::sqrt(variance.z));
+
+			float64 spread = std::sqrt(variance.x + variance.y + variance.z);
+			float64 controlOffset = glm::length(mean - Math::Vec3d(results[b].position));
+
+			out << fmt::format("{},{:.9e},{:.9e},{:.9e},{:.6e},{:.6e},{:.6e},{:.6e},{:.6e},{:.9e},{:.6e}\n",
+				world.ReadComponent<Name>(tracked[b])->name,
+				mean.x, mean.y, mean.z, sigma.x, sigma.y, sigma.z,
+				spread, controlOffset, meanSpeed, std::sqrt(m2Speed / samples));
+		}
+
+		return out.good();
+	}
+
+	String EnsembleRunner::PartPath(const EnsembleDesc& desc, uint32 worker)
+	{
+		return fmt::format("{}.part{}", desc.output, worker);
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+#include <Application/Core/Services/Managers/EntityManager/EntityManager.h>
+
+namespace Nyx
+{
+	// Plain "key value" file, '#' starts a comment (see Assets/Scenes/Ensemble.nyxensemble)
+	struct EnsembleDesc
+	{
+		String scene;          // empty keeps the default scene
+		uint32 members = 32;
+		uint32 workers = 0;    // 0 uses every core
+		uint64 seed = 1;
+		uint64 frames = 3600;
+		float32 timeScale = 1.0f;
+
+		// Gaussian perturbations applied to every rigidbody; member 0 is left unperturbed
+		float64 positionSigma = 0.0; // meters, per axis
+		float64 velocitySigma = 0.0; // m/s, per axis
+		float64 massSigma = 0.0;     // fraction of the mass
+
+		String output = "ensemble.csv";
+
+		static bool8 Load(const String& path, EnsembleDesc& desc);
+	};
+
+	// Runs perturbed copies of an initialized world without rendering, one worker process
+	// per core, and writes per-body statistics of the final states to one file. On POSIX the
+	// workers are forked from the loaded scene and share its memory copy-on-write; on Windows
+	// they are spawned with the same arguments plus --ensemble-worker and restore a snapshot
+	// written by the parent. Workers hand their results back through part files next to the
+	// output, which are merged in member order so the summary does not depend on the worker count.
+	//
+	// Massive named bodies are tracked. Massless populations are perturbed and simulated too,
+	// but they exert no pull, so they never affect the tracked bodies and are left out of the file.
+	//
+	// The world is expected to be loaded without graphics (see SceneLoader), so neither the
+	// coordinator nor the workers own a GL context or the engine's thread pool.
+	class EnsembleRunner
+	{
+	public:
+		static bool8 Run(ECS& world, const EnsembleDesc& desc, const String& executable, const String& configPath);
+
+		// Entry point of a spawned worker; `spec` is "<index>:<count>"
+		static bool8 RunWorkerProcess(ECS& world, const EnsembleDesc& desc, const String& spec);
+
+	private:
+		struct BodyState
+		{
+			Math::Vec3f position;
+			Math::Vec3f velocity;
+		};
+
+		static Vector<EntityID> TrackedBodies(ECS& world);
+		static bool8 RunWorker(ECS& world, const EnsembleDesc& desc, uint32 worker, uint32 workers);
+		static bool8 WriteSummary(ECS& world, const EnsembleDesc& desc, uint32 workers);
+
+		static String PartPath(const EnsembleDesc& desc, uint32 worker);
+		static String SnapshotPath(const EnsembleDesc& desc) { return desc.output + ".snapshot"; }
+	};
+}
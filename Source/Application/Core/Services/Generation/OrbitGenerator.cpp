@@ -0,0 +1,131 @@
+#include "OrbitGenerator.h"
+
+#include <spdlog/spdlog.h>
+
+#include <Application/Constants/Constants.h>
+#include <Application/Core/Services/Managers/SceneManager/SceneManager.h>
+#include <Application/Utils/SpaceUtils/SpaceUtils.h>
+
+namespace Nyx
+{
+	float64 Distribution::Sample(Random& random) const
+	{
+		float64 value = a;
+
+		switch (type)
+		{
+		case DistributionType::CONSTANT:
+			break;
+		case DistributionType::UNIFORM:
+			value = random.Uniform(a, b);
+			break;
+		case DistributionType::NORMAL:
+			value = random.Normal(a, b);
+			break;
+		case DistributionType::RAYLEIGH:
+			value = a * std::sqrt(-2.0 * std::log(1.0 - random.NextDouble()));
+			break;
+		case DistributionType::POWER_LAW:
+		{
+			// Inverse CDF of x^c on [a, b)
+			float64 u = random.NextDouble();
+			if (std::abs(c + 1.0) < 1e-9)
+			{
+				value = a * std::pow(b / a, u);
+			}
+			else
+			{
+				float64 k = c + 1.0;
+				value = std::pow(std::pow(a, k) + u * (std::pow(b, k) - std::pow(a, k)), 1.0 / k);
+			}
+			break;
+		}
+		}
+
+		return std::clamp(value, min, max);
+	}
+
+	void OrbitGenerator::GenerateChunk(const PopulationDesc& desc, uint32 chunk, const Transform& attractor, const Rigidbody& attractorBody,
+		Transform* transforms, Rigidbody* rigidbodies)
+	{
+		Random random = Random::ForStream(desc.seed, chunk);
+
+		uint32 first = chunk * CHUNK_SIZE;
+		uint32 count = std::min(CHUNK_SIZE, desc.count - first);
+
+		const Math::Vec3f origin = attractor.position.GetWorld();
+		const Math::Vec3f originVelocity = attractorBody.velocity.GetWorld();
+		const Math::Quatf frame = desc.alignToAttractor ? attractor.rotation.GetQuaternion() : Math::Quatf(1.0f, 0.0f, 0.0f, 0.0f);
+
+		for (uint32 i = 0; i < count; ++i)
+		{
+			// Fixed draw order per body keeps streams reproducible
+			OrbitalElements elements;
+			elements.semiMajorAxis = desc.semiMajorAxis.Sample(random);
+			elements.eccentricity = std::clamp(desc.eccentricity.Sample(random), 0.0, 0.99);
+			elements.inclination = static_cast<float32>(desc.inclination.Sample(random));
+			elements.ascendingNode = static_cast<float32>(random.Uniform(0.0, 360.0));
+			elements.argumentOfPeriapsis = static_cast<float32>(random.Uniform(0.0, 360.0));
+			elements.trueAnomaly = static_cast<float32>(random.Uniform(0.0, 360.0));
+
+			float64 mass = desc.mass.Sample(random);
+			float32 radius = static_cast<float32>(desc.radius.Sample(random));
+
+			Math::Vec3d position, velocity;
+			if (!OrbitalElementsToState(G * (attractorBody.mass + mass), elements, position, velocity))
+				position = velocity = Math::Vec3d(0.0);
+
+			Transform& transform = transforms[i];
+			transform = Transform{ Position(origin + frame * Math::Vec3f(position)), Rotation(), Scale(radius) };
+
+			Rigidbody& rigidbody = rigidbodies[i];
+			rigidbody = Rigidbody{ mass, Velocity(), Velocity(originVelocity + frame * Math::Vec3f(velocity)), Acceleration() };
+		}
+	}
+
+	void OrbitGenerator::Generate(const PopulationDesc& desc, const Transform& attractor, const Rigidbody& attractorBody,
+		Vector<Transform>& transforms, Vector<Rigidbody>& rigidbodies, ThreadPool& pool)
+	{
+		transforms.resize(desc.count);
+		rigidbodies.resize(desc.count);
+
+		uint32 chunks = (desc.count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+		for (uint32 chunk = 0; chunk < chunks; ++chunk)
+		{
+			Transform* chunkTransforms = transforms.data() + chunk * CHUNK_SIZE;
+			Rigidbody* chunkRigidbodies = rigidbodies.data() + chunk * CHUNK_SIZE;
+
+			pool.Submit([&desc, chunk, &attractor, &attractorBody, chunkTransforms, chunkRigidbodies]()
+			{
+				GenerateChunk(desc, chunk, attractor, attractorBody, chunkTransforms, chunkRigidbodies);
+			});
+		}
+
+		pool.Wait();
+	}
+
+	EntityRange OrbitGenerator::Populate(Scene& scene, EntityID attractorID, const PopulationDesc& desc, const Sphere* prototype)
+	{
+		ECS& world = scene.GetWorld();
+		if (desc.count == 0 || !world.HasComponents<Transform, Rigidbody>(attractorID))
+		{
+			spdlog::error("Cannot generate a population around entity {}", attractorID);
+			return EntityRange{};
+		}
+
+		// Copies, so the pools can grow while we insert
+		Transform attractor = *world.ReadComponent<Transform>(attractorID);
+		Rigidbody attractorBody = *world.ReadComponent<Rigidbody>(attractorID);
+
+		Vector<Transform> transforms;
+		Vector<Rigidbody> rigidbodies;
+
+		ThreadPool pool;
+		Generate(desc, attractor, attractorBody, transforms, rigidbodies, pool);
+
+		EntityRange range = scene.CreateBodies(transforms, rigidbodies, prototype);
+		world.AddComponents<Massless>(range.first, range.count, Massless{});
+
+		return range;
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+#include <Application/Core/Services/Scheduler/ThreadPool.h>
+#include <Application/Resource/Components/Components.h>
+#include <Application/Utils/MathUtils/Random.h>
+
+namespace Nyx
+{
+	class Scene;
+	struct EntityRange;
+
+	enum class DistributionType : uint8
+	{
+		CONSTANT,
+		UNIFORM,   // [a, b)
+		NORMAL,    // mean a, sigma b
+		RAYLEIGH,  // sigma a; typical for eccentricities and inclinations of a relaxed belt
+		POWER_LAW  // density ~ x^c on [a, b), e.g. ring radii or size spectra
+	};
+
+	// Samples are clamped to [min, max]
+	struct Distribution
+	{
+		DistributionType type = DistributionType::CONSTANT;
+		float64 a = 0.0;
+		float64 b = 0.0;
+		float64 c = 0.0;
+		float64 min = -std::numeric_limits<float64>::infinity();
+		float64 max = std::numeric_limits<float64>::infinity();
+
+		static Distribution Constant(float64 value) { return { DistributionType::CONSTANT, value }; }
+		static Distribution Uniform(float64 low, float64 high) { return { DistributionType::UNIFORM, low, high }; }
+		static Distribution Normal(float64 mean, float64 sigma) { return { DistributionType::NORMAL, mean, sigma }; }
+		static Distribution Rayleigh(float64 sigma) { return { DistributionType::RAYLEIGH, sigma }; }
+		static Distribution PowerLaw(float64 low, float64 high, float64 exponent) { return { DistributionType::POWER_LAW, low, high, exponent }; }
+
+		float64 Sample(Random& random) const;
+	};
+
+	// A population of massless bodies on Keplerian orbits around one attractor.
+	// Node, argument of periapsis and true anomaly are uniform over the full circle.
+	struct PopulationDesc
+	{
+		uint32 count = 0;
+		uint64 seed = 1;
+
+		Distribution semiMajorAxis;                               // meters
+		Distribution eccentricity = Distribution::Constant(0.0);
+		Distribution inclination = Distribution::Constant(0.0);   // degrees
+		Distribution mass = Distribution::Constant(1.0);          // kilograms
+		Distribution radius = Distribution::Constant(1.0);        // meters
+
+		// Orbits lie in the attractor's equatorial plane instead of the XZ plane, e.g. rings
+		bool8 alignToAttractor = false;
+	};
+
+	class OrbitGenerator
+	{
+	public:
+		// Each chunk has its own RNG stream, so the output depends on the seed only, not on threads
+		static constexpr uint32 CHUNK_SIZE = 4096;
+
+		// Fills state vectors around the attractor's current state
+		static void Generate(const PopulationDesc& desc, const Transform& attractor, const Rigidbody& attractorBody,
+			Vector<Transform>& transforms, Vector<Rigidbody>& rigidbodies, ThreadPool& pool);
+
+		// Generates and inserts through Scene::CreateBodies; the bodies share the prototype's mesh,
+		// or have none when it is null
+		static EntityRange Populate(Scene& scene, EntityID attractorID, const PopulationDesc& desc, const Sphere* prototype);
+
+	private:
+		static void GenerateChunk(const PopulationDesc& desc, uint32 chunk, const Transform& attractor, const Rigidbody& attractorBody,
+			Transform* transforms, Rigidbody* rigidbodies);
+	};
+}
@@ -0,0 +1,214 @@
+#include "InputRecorder.h"
+
+#include <cstring>
+#include <GLFW/glfw3.h>
+#include <spdlog/spdlog.h>
+
+#include <Application/Constants/Constants.h>
+#include <Application/Core/Services/Snapshot/Snapshot.h>
+
+namespace Nyx
+{
+    namespace
+    {
+        constexpr char8 MAGIC[4] = { 'N', 'Y', 'X', 'I' };
+        constexpr uint32 VERSION = 1;
+    }
+
+    bool8 InputRecorder::StartRecording(const ECS& world, const String& path)
+    {
+        Stop();
+
+        // The initial state goes first, the input stream is appended after it
+        if (!Snapshot::Save(world, path))
+            return false;
+
+        m_out.open(path, std::ios::binary | std::ios::app);
+        if (!m_out)
+        {
+            spdlog::error("Could not open {} for recording", path);
+            return false;
+        }
+
+        m_out.seekp(0, std::ios::end);
+        m_recordsOffset = static_cast<uint64>(m_out.tellp());
+        m_recordCount = 0;
+
+        m_path = path;
+        m_mode = Mode::RECORDING;
+        m_finished = false;
+        m_frame = 0;
+        m_start = std::chrono::steady_clock::now();
+
+        m_lastTimeScale = TIME_SCALE;
+        InputRecord initial;
+        initial.type = InputRecordType::TIME_SCALE;
+        initial.values[0] = TIME_SCALE;
+        Write(initial);
+
+        spdlog::info("Recording input to {}", path);
+        return true;
+    }
+
+    bool8 InputRecorder::StartReplay(ECS& world, const String& path)
+    {
+        Stop();
+
+        IfStream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+        {
+            spdlog::error("Could not open the recording {}", path);
+            return false;
+        }
+
+        uint64 size = static_cast<uint64>(in.tellg());
+        Footer footer{};
+
+        if (size < sizeof(Footer))
+        {
+            spdlog::error("{} is not a recording", path);
+            return false;
+        }
+
+        in.seekg(size - sizeof(Footer));
+        in.read(reinterpret_cast<char8*>(&footer), sizeof(Footer));
+
+        if (!in || std::memcmp(footer.magic, MAGIC, sizeof(MAGIC)) != 0 || footer.version != VERSION)
+        {
+            spdlog::error("{} is not a finished recording (version {} expected)", path, VERSION);
+            return false;
+        }
+
+        if (footer.recordsOffset + footer.recordCount * sizeof(InputRecord) + sizeof(Footer) != size)
+        {
+            spdlog::error("Recording {} is truncated", path);
+            return false;
+        }
+
+        Vector<InputRecord> records(footer.recordCount);
+        in.seekg(footer.recordsOffset);
+        in.read(reinterpret_cast<char8*>(records.data()), records.size() * sizeof(InputRecord));
+
+        if (!in || !Snapshot::Load(world, path))
+            return false;
+
+        m_records = std::move(records);
+        m_next = 0;
+        m_frameCount = footer.frameCount;
+
+        m_path = path;
+        m_mode = Mode::REPLAYING;
+        m_finished = false;
+        m_frame = 0;
+        m_start = std::chrono::steady_clock::now();
+
+        spdlog::info("Replaying {} frames ({} events) from {}", m_frameCount, m_records.size(), path);
+        return true;
+    }
+
+    void InputRecorder::Stop()
+    {
+        if (m_mode == Mode::RECORDING)
+        {
+            Footer footer{};
+            std::memcpy(footer.magic, MAGIC, sizeof(MAGIC));
+            footer.version = VERSION;
+            footer.recordsOffset = m_recordsOffset;
+            footer.recordCount = m_recordCount;
+            footer.frameCount = m_frame;
+
+            m_out.write(reinterpret_cast<const char8*>(&footer), sizeof(Footer));
+            m_out.close();
+
+            spdlog::info("Recorded {} frames ({} events) to {}", m_frame, m_recordCount, m_path);
+        }
+        else if (m_mode == Mode::REPLAYING)
+        {
+            float64 seconds = Elapsed();
+            spdlog::info("Replayed {} of {} frames from {} in {:.3f} s ({:.3f} ms/frame)",
+                m_frame, m_frameCount, m_path, seconds, m_frame > 0 ? seconds * 1000.0 / m_frame : 0.0);
+        }
+
+        m_mode = Mode::NONE;
+        m_records.clear();
+        m_keysDown.clear();
+    }
+
+    bool8 InputRecorder::Accept(InputRecord record)
+    {
+        switch (m_mode)
+        {
+        case Mode::RECORDING:
+            Write(record);
+            return true;
+        case Mode::REPLAYING:
+            return m_dispatching;
+        default:
+            return true;
+        }
+    }
+
+    void InputRecorder::EndFrame()
+    {
+        if (m_mode == Mode::RECORDING)
+        {
+            // Picked up here so it lands on the same boundary the physics step sees it at
+            if (TIME_SCALE != m_lastTimeScale)
+            {
+                InputRecord change;
+                change.type = InputRecordType::TIME_SCALE;
+                change.values[0] = TIME_SCALE;
+                Write(change);
+
+                m_lastTimeScale = TIME_SCALE;
+            }
+
+            ++m_frame;
+            return;
+        }
+
+        if (m_mode != Mode::REPLAYING)
+            return;
+
+        for (; m_next < m_records.size() && m_records[m_next].frame <= m_frame; ++m_next)
+        {
+            const InputRecord& record = m_records[m_next];
+
+            if (record.type == InputRecordType::TIME_SCALE)
+            {
+                TIME_SCALE = static_cast<float32>(record.values[0]);
+                continue;
+            }
+
+            if (record.type == InputRecordType::KEY && record.args[1] == GLFW_PRESS)
+                m_keysDown.insert(record.args[0]);
+            else if (record.type == InputRecordType::KEY && record.args[1] == GLFW_RELEASE)
+                m_keysDown.erase(record.args[0]);
+
+            if (m_sink)
+            {
+                m_dispatching = true;
+                m_sink(record);
+                m_dispatching = false;
+            }
+        }
+
+        if (++m_frame >= m_frameCount)
+            m_finished = true;
+    }
+
+    void InputRecorder::Write(const InputRecord& record)
+    {
+        InputRecord stamped = record;
+        stamped.frame = m_frame;
+        stamped.timestamp = Elapsed();
+
+        m_out.write(reinterpret_cast<const char8*>(&stamped), sizeof(InputRecord));
+        ++m_recordCount;
+    }
+
+    float64 InputRecorder::Elapsed() const
+    {
+        return std::chrono::duration<float64>(std::chrono::steady_clock::now() - m_start).count();
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <chrono>
+
+#include <Application/Core/Core.h>
+#include <Application/Core/Services/Managers/EntityManager/EntityManager.h>
+
+namespace Nyx {
+	enum class InputRecordType : uint32 {
+		MOUSE_BUTTON,
+		CURSOR_POS,
+		KEY,
+		SCROLL,
+		TIME_SCALE
+	};
+
+	// One raw window callback (or a time-scale change) in the order it arrived
+	struct InputRecord {
+		uint64 frame = 0;
+		float64 timestamp = 0.0; // seconds since the recording started
+		InputRecordType type = InputRecordType::KEY;
+		int32 args[3] = {};      // button/key, action, mods
+		float64 values[2] = {};  // cursor position, scroll offset or time scale
+	};
+
+	// Records a session to a file and plays it back frame for frame. The file starts with a
+	// snapshot of the world (so Snapshot::Load reads it directly), followed by the raw window
+	// callbacks and time-scale changes tagged with the frame they happened in, and a footer.
+	// During replay live input is dropped and the recorded callbacks are fed back at the same
+	// frame boundary, which together with the fixed DELTA_TIME reproduces the run exactly.
+	// Changes made through editor panels other than the time scale are not captured.
+	class InputRecorder : public Singleton<InputRecorder> {
+	public:
+		using Sink = function<void(const InputRecord&)>;
+
+		bool8 StartRecording(const ECS& world, const String& path);
+		bool8 StartReplay(ECS& world, const String& path);
+
+		// Writes the footer of a recording, or logs the timing of a replay
+		void Stop();
+
+		// Receives recorded callbacks during replay
+		void SetSink(Sink sink) { m_sink = std::move(sink); }
+
+		// Called by the window callbacks; false means the event is live input to be ignored
+		bool8 Accept(InputRecord record);
+
+		// Frame boundary, right after the window events have been polled
+		void EndFrame();
+
+		bool8 IsRecording() const { return m_mode == Mode::RECORDING; }
+		bool8 IsReplaying() const { return m_mode == Mode::REPLAYING; }
+		bool8 IsFinished() const { return m_finished; }
+
+		// Held keys as reconstructed from the replayed key events
+		bool8 IsKeyDown(int32 key) const { return m_keysDown.contains(key); }
+
+	private:
+		enum class Mode {
+			NONE,
+			RECORDING,
+			REPLAYING
+		};
+
+		struct Footer {
+			char8 magic[4];
+			uint32 version;
+			uint64 recordsOffset;
+			uint64 recordCount;
+			uint64 frameCount;
+		};
+
+		void Write(const InputRecord& record);
+		float64 Elapsed() const;
+
+		Mode m_mode = Mode::NONE;
+		bool8 m_dispatching = false;
+		bool8 m_finished = false;
+
+		String m_path;
+		OfStream m_out;
+		uint64 m_recordsOffset = 0;
+		uint64 m_recordCount = 0;
+		float32 m_lastTimeScale = 0.0f;
+
+		Vector<InputRecord> m_records;
+		usize m_next = 0;
+		uint64 m_frameCount = 0;
+		Set<int32> m_keysDown;
+		Sink m_sink;
+
+		uint64 m_frame = 0;
+		std::chrono::steady_clock::time_point m_start;
+	};
+}
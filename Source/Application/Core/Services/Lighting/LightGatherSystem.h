@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Application/Core/Services/Lighting/LightingSystem.h>
+#include <Application/Core/Services/Managers/SceneManager/SceneManager.h>
+#include <Application/Core/Services/Scheduler/System.h>
+
+namespace Nyx
+{
+	class LightGatherSystem : public ISystem
+	{
+	public:
+		const char8* GetName() const override { return "Light Gather"; }
+
+		void DeclareAccess(SystemAccess& access) const override
+		{
+			access.Reads<Transform>().Writes<LightComponent, LightingSystem>();
+		}
+
+		void Update(const SystemContext& context) override
+		{
+			ECS& world = *context.world;
+
+			EntityID cameraID = context.scene->GetActiveCameraID();
+			if (!world.HasComponent<Transform>(cameraID))
+				return;
+
+			const Transform& cameraTransform = *world.ReadComponent<Transform>(cameraID);
+			LightingSystem::Get().GatherLights(world, cameraTransform);
+		}
+	};
+}
@@ -6,73 +6,181 @@
 
 namespace Nyx
 {
+	// std140 mirrors of the blocks in sphere_lighting.glsl: vec3s sit on 16-byte boundaries and
+	// arrays of structs start on one, with each element rounded up to 16 bytes
+	struct DirectionalLightStd140
+	{
+		Math::Vec3f direction;
+		float32 pad0;
+		Math::Vec3f color;
+		float32 intensity;
+	};
+
+	struct PointLightStd140
+	{
+		Math::Vec3f position;
+		float32 pad0;
+		Math::Vec3f color;
+		float32 intensity;
+		float32 range;
+		float32 decay;
+		float32 pad1[2];
+	};
+
+	struct DirectionalLightBlock
+	{
+		int32 count;
+		int32 pad[3];
+		DirectionalLightStd140 lights[MAX_DIRECTIONAL_LIGHTS];
+	};
+
+	struct PointLightBlock
+	{
+		int32 count;
+		int32 pad[3];
+		PointLightStd140 lights[MAX_POINT_LIGHTS];
+	};
+
+	static_assert(sizeof(DirectionalLightStd140) == 32 && sizeof(PointLightStd140) == 48);
+	static_assert(offsetof(DirectionalLightBlock, lights) == 16 && offsetof(PointLightBlock, lights) == 16);
+
 	class LightingSystem : public Singleton<LightingSystem>
 	{
 	public:
-		Vector<LightComponent*> directionalLights;
-		Vector<LightComponent*> pointLights;
+		Vector<const LightComponent*> directionalLights;
+		Vector<const LightComponent*> pointLights;
 
-		void GatherLights(const Transform& cameraTransform)
+		// Camera-relative positions, parallel to pointLights
+		Vector<Position> pointLightPositions;
+
+		void GatherLights(ECS& world, const Transform& cameraTransform)
 		{
-			directionalLights.clear();
-			pointLights.clear();
+			uint64 tick = world.GetTick();
 
-			for (EntityID entityID : ECS::Get().View<LightComponent>())
-			{
-				auto* light = ECS::Get().GetComponent<LightComponent>(entityID);
+			// Light list only changes when a light is added, removed or edited, or the rendered world is swapped
+			bool8 rebuilt = &world != m_world || world.GetPoolVersion<LightComponent>() >= m_lastTick;
+			if (rebuilt)
+				CollectLights(world);
 
-				switch (light->type)
-				{
-				case LightType::DIRECTIONAL:
-					directionalLights.push_back(light);
-					break;
-				case LightType::POINT:
-				{
-					if (!ECS::Get().HasComponent<Transform>(entityID))
-						continue;
+			m_dirty |= rebuilt;
 
-					const Transform& transform = *ECS::Get().GetComponent<Transform>(entityID);
-					const Position& cameraPos = cameraTransform.position;
+			const Position& cameraPos = cameraTransform.position;
+			bool8 cameraMoved = rebuilt || cameraPos.GetWorld() != m_lastCameraPos;
 
-					light->position = transform.position / METERS_PER_UNIT;
-					light->position.SetWorld(light->position.GetWorld() - cameraPos.GetWorld());
+			for (size_t i = 0; i < pointLights.size(); ++i)
+			{
+				EntityID entityID = m_pointLightIDs[i];
+				if (!cameraMoved && !world.HasChangedSince<Transform>(entityID, m_lastTick))
+					continue;
 
-					pointLights.push_back(light);
-					break;
-				}
-				}
+				const Transform& transform = *world.ReadComponent<Transform>(entityID);
+
+				Position& position = pointLightPositions[i];
+				position = transform.position / METERS_PER_UNIT;
+				position.SetWorld(position.GetWorld() - cameraPos.GetWorld());
+				m_dirty = true;
 			}
+
+			m_lastCameraPos = cameraPos.GetWorld();
+			m_lastTick = tick;
 		}
 
-		void UploadToShader(uint32 shaderID)
+		// Writes the light blocks when the gathered lights changed; needs the GL context, so it
+		// runs on the render thread. Shaders read them through fixed binding points, so draws
+		// have nothing to upload.
+		void UploadBuffers()
 		{
-			int count = std::min((int)directionalLights.size(), MAX_DIRECTIONAL_LIGHTS);
-			glUniform1i(glGetUniformLocation(shaderID, "uDirLightCount"), count);
+			if (m_directionalBuffer == 0)
+			{
+				glGenBuffers(1, &m_directionalBuffer);
+				glBindBuffer(GL_UNIFORM_BUFFER, m_directionalBuffer);
+				glBufferData(GL_UNIFORM_BUFFER, sizeof(DirectionalLightBlock), nullptr, GL_DYNAMIC_DRAW);
+				glBindBufferBase(GL_UNIFORM_BUFFER, DIRECTIONAL_LIGHT_BINDING, m_directionalBuffer);
 
-			for (int i = 0; i < count; ++i)
+				glGenBuffers(1, &m_pointBuffer);
+				glBindBuffer(GL_UNIFORM_BUFFER, m_pointBuffer);
+				glBufferData(GL_UNIFORM_BUFFER, sizeof(PointLightBlock), nullptr, GL_DYNAMIC_DRAW);
+				glBindBufferBase(GL_UNIFORM_BUFFER, POINT_LIGHT_BINDING, m_pointBuffer);
+
+				m_dirty = true;
+			}
+
+			if (!m_dirty)
+				return;
+
+			DirectionalLightBlock directional{};
+			directional.count = std::min((int32)directionalLights.size(), MAX_DIRECTIONAL_LIGHTS);
+
+			for (int32 i = 0; i < directional.count; ++i)
 			{
 				const auto* l = directionalLights[i];
-				String base = "uDirectionalLights[" + std::to_string(i) + "]";
-
-				glUniform3fv(glGetUniformLocation(shaderID, (base + ".direction").c_str()), 1, glm::value_ptr(l->direction));
-				glUniform3fv(glGetUniformLocation(shaderID, (base + ".color").c_str()), 1, glm::value_ptr(l->color));
-				glUniform1f(glGetUniformLocation(shaderID, (base + ".intensity").c_str()), l->intensity);
+				directional.lights[i].direction = l->direction;
+				directional.lights[i].color = l->color;
+				directional.lights[i].intensity = l->intensity;
 			}
 
-			count = std::min((int)pointLights.size(), MAX_POINT_LIGHTS);
-			glUniform1i(glGetUniformLocation(shaderID, "uPointLightCount"), count);
+			PointLightBlock point{};
+			point.count = std::min((int32)pointLights.size(), MAX_POINT_LIGHTS);
 
-			for (int i = 0; i < count; ++i)
+			for (int32 i = 0; i < point.count; ++i)
 			{
 				const auto* l = pointLights[i];
-				String base = "uPointLights[" + std::to_string(i) + "]";
+				point.lights[i].position = pointLightPositions[i].GetWorld();
+				point.lights[i].color = l->color;
+				point.lights[i].intensity = l->intensity;
+				point.lights[i].range = l->range;
+				point.lights[i].decay = l->decay;
+			}
+
+			// Only the used part of each array is sent
+			glBindBuffer(GL_UNIFORM_BUFFER, m_directionalBuffer);
+			glBufferSubData(GL_UNIFORM_BUFFER, 0, offsetof(DirectionalLightBlock, lights) + directional.count * sizeof(DirectionalLightStd140), &directional);
+
+			glBindBuffer(GL_UNIFORM_BUFFER, m_pointBuffer);
+			glBufferSubData(GL_UNIFORM_BUFFER, 0, offsetof(PointLightBlock, lights) + point.count * sizeof(PointLightStd140), &point);
+
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			m_dirty = false;
+		}
+
+	private:
+		void CollectLights(ECS& world)
+		{
+			m_world = &world;
+
+			directionalLights.clear();
+			pointLights.clear();
+			m_pointLightIDs.clear();
 
-				glUniform3fv(glGetUniformLocation(shaderID, (base + ".position").c_str()), 1, glm::value_ptr(l->position.GetWorld()));
-				glUniform3fv(glGetUniformLocation(shaderID, (base + ".color").c_str()), 1, glm::value_ptr(l->color));
-				glUniform1f(glGetUniformLocation(shaderID, (base + ".intensity").c_str()), l->intensity);
-				glUniform1f(glGetUniformLocation(shaderID, (base + ".range").c_str()), l->range);
-				glUniform1f(glGetUniformLocation(shaderID, (base + ".decay").c_str()), l->decay);
+			for (EntityID entityID : world.View<LightComponent>())
+			{
+				const auto* light = world.ReadComponent<LightComponent>(entityID);
+
+				switch (light->type)
+				{
+				case LightType::DIRECTIONAL:
+					directionalLights.push_back(light);
+					break;
+				case LightType::POINT:
+					if (!world.HasComponent<Transform>(entityID))
+						continue;
+
+					pointLights.push_back(light);
+					m_pointLightIDs.push_back(entityID);
+					break;
+				}
 			}
+
+			pointLightPositions.resize(pointLights.size());
 		}
+
+		const ECS* m_world = nullptr;
+		Vector<EntityID> m_pointLightIDs;
+		Math::Vec3f m_lastCameraPos = Math::Vec3f(0.0f);
+		uint64 m_lastTick = 0;
+
+		uint32 m_directionalBuffer = 0;
+		uint32 m_pointBuffer = 0;
+		bool8 m_dirty = true;
 	};
-}
\ No newline at end of file
+}
@@ -1,15 +1,238 @@
 #pragma once
+#include <bit>
+#include <limits>
+#include <typeinfo>
 #include <spdlog/spdlog.h>
 
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
 #include <Application/Core/Core.h>
 #include <Application/Resource/Components/Transform/Position.h>
 
 namespace Nyx {
 	using EntityID = uint32_t;
+	using ComponentTypeID = uint32;
+
+	// One bit per component type; an entity's signature says which pools hold it
+	using Signature = uint64;
+	constexpr uint32 MAX_COMPONENT_TYPES = 64;
+
+	// Hands out dense per-process IDs so pools and signature bits can be indexed directly
+	class ComponentTypes
+	{
+	public:
+		template<typename T>
+		static ComponentTypeID ID()
+		{
+			static const ComponentTypeID id = Next();
+			return id;
+		}
+
+		template<typename T>
+		static Signature Bit()
+		{
+			return Signature(1) << ID<T>();
+		}
+
+		// Readable type name for diagnostics, without namespaces
+		template<typename T>
+		static String Name()
+		{
+			String name = typeid(T).name();
+
+#ifdef __GNUG__
+			int32 status = 0;
+			char8* demangled = abi::__cxa_demangle(name.data(), nullptr, nullptr, &status);
+			if (status == 0 && demangled != nullptr)
+				name = demangled;
+			std::free(demangled);
+#endif
+
+			// MSVC prefixes "struct " / "class "
+			usize space = name.rfind(' ');
+			if (space != String::npos)
+				name = name.substr(space + 1);
+
+			usize scope = name.rfind("::");
+			if (scope != String::npos)
+				name = name.substr(scope + 2);
+
+			return name;
+		}
+
+	private:
+		static ComponentTypeID Next()
+		{
+			static Atomic<ComponentTypeID> next = 0;
+
+			ComponentTypeID id = next++;
+			assert(id < MAX_COMPONENT_TYPES && "Signature is out of bits, widen Signature");
+			return id;
+		}
+	};
+
+	// Per-world state that isn't a component, such as caches derived from the pools
+	class IWorldResource
+	{
+	public:
+		virtual ~IWorldResource() = default;
+	};
+
+	// Dense per-process IDs for resource types, so a world's resources are indexed directly
+	class WorldResourceTypes
+	{
+	public:
+		template<typename T>
+		static uint32 ID()
+		{
+			static const uint32 id = next++;
+			return id;
+		}
+
+	private:
+		static inline Atomic<uint32> next = 0;
+	};
+
+	// Memory and occupancy of one component pool
+	struct PoolStats
+	{
+		String name;
+		ComponentTypeID type = 0;
+		usize elementSize = 0;
+		usize count = 0;
+		usize capacity = 0;
+		usize bytesUsed = 0;     // live components with their version and entity slots
+		usize bytesReserved = 0; // the same, at capacity
+		usize sparseSize = 0;    // length of the EntityID -> index table
+		usize sparseBytes = 0;   // reserved bytes of that table
+	};
+
+	struct EntityStats
+	{
+		EntityID nextID = 0;
+		usize alive = 0;
+		usize freeListSize = 0;
+		usize freeListRuns = 0;  // contiguous ID ranges in the free list; high means scattered holes
+		usize bytes = 0;
+	};
+
+	struct WorldStats
+	{
+		EntityStats entities;
+		Vector<PoolStats> pools;
+		usize signatureBytes = 0;
+		usize totalBytes = 0;
+	};
 
 	class EntityManager {
 	public:
+		EntityManager() = default;
+
+		// The allocation lock is per instance and never copied
+		EntityManager(const EntityManager& other)
+			: m_nextID(other.m_nextID), m_freeList(other.m_freeList), m_alive(other.m_alive) {}
+
+		EntityManager& operator=(const EntityManager& other)
+		{
+			m_nextID = other.m_nextID;
+			m_freeList = other.m_freeList;
+			m_alive = other.m_alive;
+			return *this;
+		}
+
 		EntityID CreateEntity() 
+		{
+			EntityID id = ReserveEntity();
+			CommitEntity(id);
+			return id;
+		}
+
+		// Hands out an ID without making it alive yet. Safe to call from any thread.
+		EntityID ReserveEntity()
+		{
+			LockGuard<Mutex> lock(m_allocMutex);
+			return AllocateID();
+		}
+
+		// Hands out `count` consecutive IDs past the high-water mark; the free list is left alone
+		EntityID ReserveRange(uint32 count)
+		{
+			LockGuard<Mutex> lock(m_allocMutex);
+
+			EntityID first = m_nextID;
+			m_nextID += count;
+			return first;
+		}
+
+		void CommitRange(EntityID first, uint32 count)
+		{
+			if (first + count > m_alive.size())
+				m_alive.resize(first + count, false);
+
+			std::fill_n(m_alive.begin() + first, count, true);
+		}
+
+		void CommitEntity(EntityID id)
+		{
+			if (id >= m_alive.size())
+				m_alive.resize(id + 1, false);
+
+			m_alive[id] = true;
+		}
+
+		void DestroyEntity(EntityID id)
+		{
+			if (id == NO_ID || !IsAlive(id))
+				return;
+
+			if (id < m_alive.size())
+				m_alive[id] = false;
+
+			LockGuard<Mutex> lock(m_allocMutex);
+			m_freeList.push_back(id);
+		}
+
+		bool IsAlive(EntityID id) const
+		{
+			return id < m_alive.size() && m_alive[id];
+		}
+
+		EntityID GetNextID() const { return m_nextID; }
+		const Vector<EntityID>& GetFreeList() const { return m_freeList; }
+
+		EntityStats GetStats() const
+		{
+			EntityStats stats;
+			stats.nextID = m_nextID;
+			stats.alive = static_cast<usize>(std::count(m_alive.begin(), m_alive.end(), true));
+			stats.freeListSize = m_freeList.size();
+			stats.bytes = m_freeList.capacity() * sizeof(EntityID) + m_alive.capacity() / 8;
+
+			Vector<EntityID> sorted = m_freeList;
+			std::sort(sorted.begin(), sorted.end());
+			for (usize i = 0; i < sorted.size(); ++i)
+			{
+				if (i == 0 || sorted[i] != sorted[i - 1] + 1)
+					++stats.freeListRuns;
+			}
+
+			return stats;
+		}
+		const Vector<bool8>& GetAliveFlags() const { return m_alive; }
+
+		// Replaces the whole allocation state, e.g. when restoring a snapshot
+		void Restore(EntityID nextID, Vector<EntityID> freeList, Vector<bool8> alive)
+		{
+			LockGuard<Mutex> lock(m_allocMutex);
+			m_nextID = nextID;
+			m_freeList = std::move(freeList);
+			m_alive = std::move(alive);
+		}
+
+	private:
+		EntityID AllocateID()
 		{
 			EntityID id;
 			if (!m_freeList.empty())
@@ -20,7 +243,7 @@ namespace Nyx {
 				if (id == NO_ID) 
 				{
 					spdlog::warn("Attempted to reuse NO_ID (0). Skipping.");
-					return CreateEntity(); // recursive call; will go to nextID instead
+					return AllocateID(); // recursive call; will go to nextID instead
 				}
 			}
 			else
@@ -28,138 +251,439 @@ namespace Nyx {
 				id = m_nextID++;
 			}
 
-			m_alive[id] = true;
 			return id;
 		}
 
-		void DestroyEntity(EntityID id)
-		{
-			if (id == NO_ID)
-				return;
-
-			m_alive[id] = false;
-			m_freeList.push_back(id);
-		}
-
-		bool IsAlive(EntityID id) const
-		{
-			auto it = m_alive.find(id);
-			return it != m_alive.end() && it->second;
-		}
-
-	private:
 		EntityID m_nextID = NO_ID;
 		Vector<EntityID> m_freeList;
-		HashMap<EntityID, bool> m_alive;
+		Vector<bool8> m_alive;
+		Mutex m_allocMutex;
 	};
 
 	struct IComponentPool
 	{
-		virtual void Remove(EntityID id) = 0;
+		virtual void Remove(EntityID id, uint64 tick) = 0;
+		virtual UniquePtr<IComponentPool> Clone() const = 0;
+		virtual PoolStats GetStats() const = 0;
 		virtual ~IComponentPool() = default;
 	};
 
+	// Every mutable access stamps the component with the current world tick,
+	// so consumers can skip entities that have not changed since they last looked.
+	// Lookups go through a sparse array indexed by EntityID instead of a hash map.
 	template<typename T>
 	class ComponentPool : public IComponentPool
 	{
 	public:
-		void Add(EntityID id, const T& component)
+		static constexpr uint32 INVALID_INDEX = std::numeric_limits<uint32>::max();
+
+		void Add(EntityID id, const T& component, uint64 tick)
 		{
 			assert(!Has(id)); // already done
-			size_t index = components.size();
+			uint32 index = static_cast<uint32>(components.size());
 			components.push_back(component);
-			entityToIndex[id] = index;
+			versions.push_back(tick);
 			indexToEntity.push_back(id);
-			assert(entityToIndex[id] == index); // sanity check
+
+			GrowSparse(id + 1);
+			sparse[id] = index;
 			assert(index < components.size());  // valid range
+
+			m_lastModified = m_lastStructuralChange = tick;
 		}
 
-		void Remove(EntityID id) override
+		// Appends one component per entity in [first, first + count) with a single growth step
+		void AddRange(EntityID first, Span<const T> range, uint64 tick)
+		{
+			uint32 index = static_cast<uint32>(components.size());
+			uint32 count = static_cast<uint32>(range.size());
+
+			Reserve(components.size() + count);
+			GrowSparse(first + count);
+
+			components.insert(components.end(), range.begin(), range.end());
+			versions.insert(versions.end(), count, tick);
+
+			for (uint32 i = 0; i < count; ++i)
+			{
+				assert(!Has(first + i)); // already done
+				indexToEntity.push_back(first + i);
+				sparse[first + i] = index + i;
+			}
+
+			m_lastModified = m_lastStructuralChange = tick;
+		}
+
+		// Same as above, with every entity getting a copy of one component
+		void AddRange(EntityID first, uint32 count, const T& component, uint64 tick)
+		{
+			uint32 index = static_cast<uint32>(components.size());
+
+			Reserve(components.size() + count);
+			GrowSparse(first + count);
+
+			components.insert(components.end(), count, component);
+			versions.insert(versions.end(), count, tick);
+
+			for (uint32 i = 0; i < count; ++i)
+			{
+				assert(!Has(first + i)); // already done
+				indexToEntity.push_back(first + i);
+				sparse[first + i] = index + i;
+			}
+
+			m_lastModified = m_lastStructuralChange = tick;
+		}
+
+		// Replaces the whole pool in one go; every component counts as changed
+		void Assign(Vector<EntityID>&& entities, Vector<T>&& values, uint64 tick)
+		{
+			assert(entities.size() == values.size());
+
+			for (EntityID id : indexToEntity)
+				sparse[id] = INVALID_INDEX;
+
+			components = std::move(values);
+			indexToEntity = std::move(entities);
+			versions.assign(components.size(), tick);
+
+			EntityID maxID = 0;
+			for (EntityID id : indexToEntity)
+				maxID = std::max(maxID, id);
+
+			GrowSparse(indexToEntity.empty() ? 0 : maxID + 1);
+			for (uint32 i = 0; i < indexToEntity.size(); ++i)
+				sparse[indexToEntity[i]] = i;
+
+			m_lastModified = m_lastStructuralChange = tick;
+		}
+
+		void Reserve(size_t capacity)
+		{
+			components.reserve(capacity);
+			versions.reserve(capacity);
+			indexToEntity.reserve(capacity);
+		}
+
+		void Remove(EntityID id, uint64 tick) override
 		{
 			if (!Has(id))
 				return; // TODO: Convert to an assert(Has(id));
 
-			size_t index = entityToIndex[id];
-			size_t last = components.size() - 1;
+			uint32 index = sparse[id];
+			uint32 last = static_cast<uint32>(components.size() - 1);
 
 			std::swap(components[index], components[last]);
+			std::swap(versions[index], versions[last]);
 			std::swap(indexToEntity[index], indexToEntity[last]);
-			entityToIndex[indexToEntity[index]] = index;
+			sparse[indexToEntity[index]] = index;
 
 			components.pop_back();
+			versions.pop_back();
 			indexToEntity.pop_back();
-			entityToIndex.erase(id);
+			sparse[id] = INVALID_INDEX;
+
+			m_lastModified = m_lastStructuralChange = tick;
+		}
+
+		UniquePtr<IComponentPool> Clone() const override
+		{
+			return MakeUnique<ComponentPool<T>>(*this);
+		}
+
+		PoolStats GetStats() const override
+		{
+			constexpr usize slotSize = sizeof(T) + sizeof(uint64) + sizeof(EntityID);
+
+			PoolStats stats;
+			stats.name = ComponentTypes::Name<T>();
+			stats.type = ComponentTypes::ID<T>();
+			stats.elementSize = sizeof(T);
+			stats.count = components.size();
+			stats.capacity = components.capacity();
+			stats.bytesUsed = stats.count * slotSize;
+			stats.bytesReserved = components.capacity() * sizeof(T) + versions.capacity() * sizeof(uint64) + indexToEntity.capacity() * sizeof(EntityID);
+			stats.sparseSize = sparse.size();
+			stats.sparseBytes = sparse.capacity() * sizeof(uint32);
+			return stats;
 		}
 
 		bool Has(EntityID id) const
 		{
-			return entityToIndex.find(id) != entityToIndex.end();
+			return id < sparse.size() && sparse[id] != INVALID_INDEX;
 		}
 
-		T* Get(EntityID id)
+		T* Get(EntityID id, uint64 tick)
 		{
-			auto it = entityToIndex.find(id);
-			if (it != entityToIndex.end())
-				return &components[it->second];
+			if (!Has(id))
+				return nullptr;
+
+			uint32 index = sparse[id];
+			versions[index] = tick;
+			m_lastModified = tick;
+			return &components[index];
+		}
+
+		const T* Read(EntityID id) const
+		{
+			return Has(id) ? &components[sparse[id]] : nullptr;
+		}
 
-			return nullptr;
+		Vector<T>& GetAll(uint64 tick)
+		{
+			std::fill(versions.begin(), versions.end(), tick);
+			m_lastModified = tick;
+			return components;
 		}
 
-		Vector<T>& GetAll() { return components; }
+		const Vector<T>& ReadAll() const { return components; }
 
 		Vector<EntityID>& GetEntityIDs() { return indexToEntity; }
+		const Vector<EntityID>& GetEntityIDs() const { return indexToEntity; }
+
+		uint64 GetVersion(EntityID id) const
+		{
+			return Has(id) ? versions[sparse[id]] : 0;
+		}
+
+		uint64 GetLastModified() const { return m_lastModified; }
+		uint64 GetLastStructuralChange() const { return m_lastStructuralChange; }
+
+		void CollectChangedSince(uint64 tick, Vector<EntityID>& out) const
+		{
+			if (m_lastModified < tick)
+				return;
+
+			for (size_t i = 0; i < versions.size(); ++i)
+			{
+				if (versions[i] >= tick)
+					out.push_back(indexToEntity[i]);
+			}
+		}
 
 	private:
+		void GrowSparse(size_t size)
+		{
+			if (size <= sparse.size())
+				return;
+
+			// Geometric growth so one-by-one inserts stay amortized
+			if (size > sparse.capacity())
+				sparse.reserve(std::max(size, sparse.capacity() * 2));
+
+			sparse.resize(size, INVALID_INDEX);
+		}
+
 		Vector<T> components;
+		Vector<uint64> versions;
 		Vector<EntityID> indexToEntity;
-		HashMap<EntityID, size_t> entityToIndex;
+		Vector<uint32> sparse;
+
+		uint64 m_lastModified = 0;
+		uint64 m_lastStructuralChange = 0;
+	};
+
+	class ECS;
+
+	enum class CommandType : uint8
+	{
+		CREATE_ENTITY,
+		ADD_COMPONENT,
+		REMOVE_COMPONENT,
+		DESTROY_ENTITY
+	};
+
+	struct EntityCommand
+	{
+		CommandType type;
+		ComponentTypeID componentKey = 0;
+		EntityID entity = NO_ID;
+		uint64 sequence = 0;
+		function<void(ECS&)> apply;
+	};
+
+	// Records structural changes from inside a system. Nothing touches the pools
+	// until the ECS flushes all buffers at the next sync point.
+	class CommandBuffer
+	{
+	public:
+		CommandBuffer(ECS& world) : m_world(world) {}
+
+		// The returned ID is reserved immediately but only becomes alive on flush
+		EntityID CreateEntity();
+		void DestroyEntity(EntityID id);
+
+		template<typename T>
+		void AddComponent(EntityID id, const T& component);
+
+		template<typename T>
+		void RemoveComponent(EntityID id);
+
+		bool8 IsEmpty() const { return m_commands.empty(); }
+
+	private:
+		friend class ECS;
+
+		void Record(CommandType type, EntityID id, ComponentTypeID componentKey, function<void(ECS&)> apply);
+
+		ECS& m_world;
+		Vector<EntityCommand> m_commands;
 	};
 
-	class ECS : public Singleton<ECS>
+	// One independent world. Every Scene owns its own, so several can be simulated side by side.
+	class ECS
 	{
 	public:
+		ECS() = default;
+		ECS(const ECS&) = delete;
+		ECS& operator=(const ECS&) = delete;
+
+		// Deep copy of every entity and component; pending commands are not carried over
+		UniquePtr<ECS> Clone() const
+		{
+			assert(!IsDeferred() && "Cannot clone a world while its systems are running");
+
+			UniquePtr<ECS> world = MakeUnique<ECS>();
+			world->m_entityManager = m_entityManager;
+			world->m_signatures = m_signatures;
+			world->m_tick = m_tick;
+
+			world->m_componentPools.resize(m_componentPools.size());
+			for (size_t i = 0; i < m_componentPools.size(); ++i)
+			{
+				if (m_componentPools[i])
+					world->m_componentPools[i] = m_componentPools[i]->Clone();
+			}
+
+			return world;
+		}
+
 		EntityID CreateEntity()
 		{
+			assert(!IsDeferred() && "Use GetCommandBuffer() while systems are running");
 			return m_entityManager.CreateEntity();
 		}
 
+		// Creates `count` entities with consecutive IDs and returns the first one
+		EntityID CreateEntities(uint32 count)
+		{
+			assert(!IsDeferred() && "Use GetCommandBuffer() while systems are running");
+
+			EntityID first = m_entityManager.ReserveRange(count);
+			m_entityManager.CommitRange(first, count);
+
+			if (first + count > m_signatures.size())
+				m_signatures.resize(first + count, 0);
+
+			return first;
+		}
+
 		void DestroyEntity(EntityID id)
 		{
+			assert(!IsDeferred() && "Use GetCommandBuffer() while systems are running");
 			m_entityManager.DestroyEntity(id);
-			for (auto& [_, pool] : m_componentPools)
+
+			if (id >= m_signatures.size())
+				return;
+
+			// Visit only the pools this entity actually lives in
+			Signature signature = m_signatures[id];
+			while (signature != 0)
 			{
-				pool->Remove(id);
+				ComponentTypeID type = std::countr_zero(signature);
+				m_componentPools[type]->Remove(id, m_tick);
+				signature &= signature - 1;
 			}
+
+			m_signatures[id] = 0;
 		}
 
 		template<typename T>
 		void AddComponent(EntityID id, const T& component)
 		{
-			GetOrCreatePool<T>().Add(id, component);
+			assert(!IsDeferred() && "Use GetCommandBuffer() while systems are running");
+			GetOrCreatePool<T>().Add(id, component, m_tick);
+
+			if (id >= m_signatures.size())
+				m_signatures.resize(id + 1, 0);
+
+			m_signatures[id] |= ComponentTypes::Bit<T>();
+		}
+
+		// Batch insert for the consecutive entities starting at `first`, one component each
+		template<typename T>
+		void AddComponents(EntityID first, Span<const T> components)
+		{
+			assert(!IsDeferred() && "Use GetCommandBuffer() while systems are running");
+			GetOrCreatePool<T>().AddRange(first, components, m_tick);
+			MarkRange(first, static_cast<uint32>(components.size()), ComponentTypes::Bit<T>());
+		}
+
+		template<typename T>
+		void AddComponents(EntityID first, uint32 count, const T& component)
+		{
+			assert(!IsDeferred() && "Use GetCommandBuffer() while systems are running");
+			GetOrCreatePool<T>().AddRange(first, count, component, m_tick);
+			MarkRange(first, count, ComponentTypes::Bit<T>());
+		}
+
+		// Pre-sizes a pool ahead of many single adds
+		template<typename T>
+		void ReserveComponents(size_t capacity)
+		{
+			GetOrCreatePool<T>().Reserve(capacity);
 		}
 
 		template<typename T>
 		void RemoveComponent(EntityID id)
 		{
-			GetPool<T>()->Remove(id);
+			assert(!IsDeferred() && "Use GetCommandBuffer() while systems are running");
+			GetPool<T>()->Remove(id, m_tick);
+
+			if (id < m_signatures.size())
+				m_signatures[id] &= ~ComponentTypes::Bit<T>();
 		}
 
 		template<typename T>
-		bool HasComponent(EntityID id) {
-			if (GetPool<T>() == nullptr)
-				return false;
+		bool HasComponent(EntityID id) const {
+			return HasComponents<T>(id);
+		}
 
-			return GetPool<T>()->Has(id);
+		template<typename... T>
+		bool8 HasComponents(EntityID id) const {
+			Signature mask = SignatureOf<T...>();
+			return id < m_signatures.size() && (m_signatures[id] & mask) == mask;
 		}
 
+		Signature GetSignature(EntityID id) const {
+			return id < m_signatures.size() ? m_signatures[id] : 0;
+		}
+
+		template<typename... T>
+		static Signature SignatureOf() {
+			return (Signature(0) | ... | ComponentTypes::Bit<T>());
+		}
+
+		// Mutable access; marks the component as changed this tick
 		template<typename T>
 		T* GetComponent(EntityID id) {
-			return GetPool<T>()->Get(id);
+			return GetPool<T>()->Get(id, m_tick);
+		}
+
+		// Read-only access; leaves change tracking untouched
+		template<typename T>
+		const T* ReadComponent(EntityID id) {
+			return GetPool<T>()->Read(id);
 		}
 
 		template<typename T>
 		Vector<T>& GetAllComponents() {
-			return GetPool<T>()->GetAll();
+			return GetPool<T>()->GetAll(m_tick);
+		}
+
+		template<typename T>
+		const Vector<T>& ReadAllComponents() {
+			return GetPool<T>()->ReadAll();
 		}
 
 		template<typename T>
@@ -168,19 +692,58 @@ namespace Nyx {
 			return GetPool<T>()->GetEntityIDs();
 		}
 
+		// Snapshot of allocation state for diagnostics; walks every pool, so not for per-frame use
+		WorldStats GetStats() const
+		{
+			WorldStats stats;
+			stats.entities = m_entityManager.GetStats();
+			stats.signatureBytes = m_signatures.capacity() * sizeof(Signature);
+			stats.totalBytes = stats.entities.bytes + stats.signatureBytes;
+
+			for (const auto& pool : m_componentPools)
+			{
+				if (!pool)
+					continue;
+
+				stats.pools.push_back(pool->GetStats());
+				stats.totalBytes += stats.pools.back().bytesReserved + stats.pools.back().sparseBytes;
+			}
+
+			return stats;
+		}
+
+		// Number of live T components; 0 if no T was ever added
+		template<typename T>
+		usize GetComponentCount() const
+		{
+			auto* pool = GetPool<T>();
+			return pool != nullptr ? pool->GetEntityIDs().size() : 0;
+		}
+
 		template<typename... T>
 		Vector<EntityID> View()
 		{
 			Vector<EntityID> result;
 
-			// For now we assume the first component type T0 gives us a good pool to iterate
 			if constexpr (sizeof...(T) > 0) {
-				auto* pool = GetPool<std::tuple_element_t<0, std::tuple<T...>>>();
-				if (pool == nullptr)
+				// Walk the smallest pool and filter the rest with a single mask test
+				const Vector<EntityID>* smallest = nullptr;
+				bool8 missingPool = false;
+
+				([&]() {
+					auto* pool = GetPool<T>();
+					if (pool == nullptr)
+						missingPool = true;
+					else if (smallest == nullptr || pool->GetEntityIDs().size() < smallest->size())
+						smallest = &pool->GetEntityIDs();
+				}(), ...);
+
+				if (missingPool)
 					return result;
 
-				for (EntityID id : pool->GetEntityIDs()) {
-					if ((HasComponent<T>(id) && ...)) {
+				Signature mask = SignatureOf<T...>();
+				for (EntityID id : *smallest) {
+					if ((m_signatures[id] & mask) == mask) {
 						result.push_back(id);
 					}
 				}
@@ -189,31 +752,171 @@ namespace Nyx {
 			return result;
 		}
 
+		uint64 GetTick() const { return m_tick; }
+
+		// Called once per frame at the sync point
+		void AdvanceTick() { ++m_tick; }
+
+		// Entities whose T was mutably accessed (or added) at or after the given tick
+		template<typename T>
+		Vector<EntityID> ChangedSince(uint64 tick)
+		{
+			Vector<EntityID> result;
+			if (auto* pool = GetPool<T>())
+				pool->CollectChangedSince(tick, result);
+
+			return result;
+		}
+
+		template<typename T>
+		bool8 HasChangedSince(EntityID id, uint64 tick)
+		{
+			auto* pool = GetPool<T>();
+			return pool != nullptr && pool->GetVersion(id) >= tick;
+		}
+
+		// Last tick at which any T was added, removed or mutably accessed
+		template<typename T>
+		uint64 GetPoolVersion()
+		{
+			auto* pool = GetPool<T>();
+			return pool != nullptr ? pool->GetLastModified() : 0;
+		}
+
+		// Last tick at which a T was added or removed
+		template<typename T>
+		uint64 GetPoolStructureVersion()
+		{
+			auto* pool = GetPool<T>();
+			return pool != nullptr ? pool->GetLastStructuralChange() : 0;
+		}
+
+		// Created on first use and owned by this world; Clone starts the copy without any
+		template<typename T>
+		T& GetResource()
+		{
+			static_assert(std::is_base_of_v<IWorldResource, T>);
+
+			LockGuard<Mutex> lock(m_resourceMutex);
+
+			uint32 type = WorldResourceTypes::ID<T>();
+			if (type >= m_resources.size())
+				m_resources.resize(type + 1);
+
+			if (!m_resources[type])
+				m_resources[type] = MakeUnique<T>();
+
+			return *static_cast<T*>(m_resources[type].get());
+		}
+
+		// Returns the calling thread's buffer; fetch it once per system run
+		CommandBuffer& GetCommandBuffer()
+		{
+			LockGuard<Mutex> lock(m_commandMutex);
+
+			UniquePtr<CommandBuffer>& buffer = m_commandBuffers[CurrentThread::get_id()];
+			if (!buffer)
+				buffer = MakeUnique<CommandBuffer>(*this);
+
+			return *buffer;
+		}
+
+		// While deferred, pools are only read or mutated in place, never resized
+		void BeginDeferred() { ++m_deferDepth; }
+
+		void EndDeferred()
+		{
+			if (--m_deferDepth == 0)
+				FlushCommands();
+		}
+
+		bool8 IsDeferred() const { return m_deferDepth > 0; }
+
+		// Applies every recorded command in one pass, grouped by entity. Commands on different
+		// entities commute, but one entity's must run in the order they were recorded, or e.g.
+		// a Remove then Add that replaces a component would run as Add then Remove.
+		void FlushCommands()
+		{
+			Vector<EntityCommand> commands;
+			{
+				LockGuard<Mutex> lock(m_commandMutex);
+				for (auto& [_, buffer] : m_commandBuffers)
+				{
+					std::move(buffer->m_commands.begin(), buffer->m_commands.end(), std::back_inserter(commands));
+					buffer->m_commands.clear();
+				}
+			}
+
+			if (commands.empty())
+				return;
+
+			std::sort(commands.begin(), commands.end(), [](const EntityCommand& a, const EntityCommand& b)
+			{
+				return std::tie(a.entity, a.sequence) < std::tie(b.entity, b.sequence);
+			});
+
+			for (EntityCommand& command : commands)
+				command.apply(*this);
+		}
+
 	private:
+		friend class CommandBuffer;
+		friend class Snapshot;
+
 		template<typename T>
 		ComponentPool<T>* GetPool()
 		{
-			auto it = m_componentPools.find(typeid(T));
-			if (it == m_componentPools.end())
+			ComponentTypeID type = ComponentTypes::ID<T>();
+			if (type >= m_componentPools.size())
+				return nullptr;
+			return static_cast<ComponentPool<T>*>(m_componentPools[type].get());
+		}
+
+		template<typename T>
+		const ComponentPool<T>* GetPool() const
+		{
+			ComponentTypeID type = ComponentTypes::ID<T>();
+			if (type >= m_componentPools.size())
 				return nullptr;
-			return static_cast<ComponentPool<T>*>(it->second.get());
+			return static_cast<const ComponentPool<T>*>(m_componentPools[type].get());
 		}
 
 		template<typename T>
 		ComponentPool<T>& GetOrCreatePool()
 		{
-			auto it = m_componentPools.find(typeid(T));
-			if (it == m_componentPools.end())
-			{
-				auto pool = std::make_unique<ComponentPool<T>>();
-				m_componentPools[typeid(T)] = std::unique_ptr<IComponentPool>(pool.release());
-			}
+			ComponentTypeID type = ComponentTypes::ID<T>();
+			if (type >= m_componentPools.size())
+				m_componentPools.resize(type + 1);
+
+			if (!m_componentPools[type])
+				m_componentPools[type] = MakeUnique<ComponentPool<T>>();
 			
-			return *static_cast<ComponentPool<T>*>(m_componentPools[typeid(T)].get());
+			return *static_cast<ComponentPool<T>*>(m_componentPools[type].get());
+		}
+
+		void MarkRange(EntityID first, uint32 count, Signature bit)
+		{
+			if (first + count > m_signatures.size())
+				m_signatures.resize(first + count, 0);
+
+			for (uint32 i = 0; i < count; ++i)
+				m_signatures[first + i] |= bit;
 		}
 
 		EntityManager m_entityManager;
-		HashMap<TypeIndex, UniquePtr<IComponentPool>> m_componentPools;
+
+		// Both indexed directly; pools by ComponentTypeID, signatures by EntityID
+		Vector<UniquePtr<IComponentPool>> m_componentPools;
+		Vector<Signature> m_signatures;
+		uint64 m_tick = 1;
+
+		Mutex m_commandMutex;
+		HashMap<Thread::id, UniquePtr<CommandBuffer>> m_commandBuffers;
+		Atomic<uint64> m_commandSequence = 0;
+		Atomic<uint32> m_deferDepth = 0;
+
+		Mutex m_resourceMutex;
+		Vector<UniquePtr<IWorldResource>> m_resources; // indexed by WorldResourceTypes::ID
 
 		template<typename T>
 		static void DeletePool(void* ptr)
@@ -221,4 +924,44 @@ namespace Nyx {
 			delete static_cast<ComponentPool<T>*>(ptr);
 		}
 	};
-}
\ No newline at end of file
+
+	inline EntityID CommandBuffer::CreateEntity()
+	{
+		EntityID id = m_world.m_entityManager.ReserveEntity();
+		Record(CommandType::CREATE_ENTITY, id, 0, [id](ECS& world) { world.m_entityManager.CommitEntity(id); });
+		return id;
+	}
+
+	inline void CommandBuffer::DestroyEntity(EntityID id)
+	{
+		Record(CommandType::DESTROY_ENTITY, id, 0, [id](ECS& world) { world.DestroyEntity(id); });
+	}
+
+	template<typename T>
+	void CommandBuffer::AddComponent(EntityID id, const T& component)
+	{
+		Record(CommandType::ADD_COMPONENT, id, ComponentTypes::ID<T>(), [id, component](ECS& world) { world.AddComponent(id, component); });
+	}
+
+	template<typename T>
+	void CommandBuffer::RemoveComponent(EntityID id)
+	{
+		Record(CommandType::REMOVE_COMPONENT, id, ComponentTypes::ID<T>(), [id](ECS& world)
+		{
+			if (world.HasComponent<T>(id))
+				world.RemoveComponent<T>(id);
+		});
+	}
+
+	inline void CommandBuffer::Record(CommandType type, EntityID id, ComponentTypeID componentKey, function<void(ECS&)> apply)
+	{
+		EntityCommand command;
+		command.type = type;
+		command.componentKey = componentKey;
+		command.entity = id;
+		command.sequence = m_world.m_commandSequence++;
+		command.apply = std::move(apply);
+
+		m_commands.push_back(std::move(command));
+	}
+}
@@ -2,7 +2,10 @@
 
 #include "ResourceManager.h"
 #include <Application/Core/Services/ResourceLocator/ResourceLocator.h>
+#include <Application/Utils/MeshUtils/MeshBuilder.h>
+#include <Application/Core/Services/Pipeline/StateCache/GLStateCache.h>
 
+#include <algorithm>
 #include <spdlog/spdlog.h>
 
 namespace Nyx
@@ -65,10 +68,24 @@ namespace Nyx
 
 		String path = ResourceLocator::Get(texturePath);
 
-		auto texture = MakeUnique<Texture>(path, false);
+		return StoreMipmapped(name, MakeUnique<Texture>(path, false));
+	}
 
+	Texture& ResourceManager::AddMipmappedTexture(const String& name, const TextureData& image)
+	{
+		auto it = m_textures.find(name);
+		if (it != m_textures.end())
+		{
+			return *(it->second);
+		}
+
+		return StoreMipmapped(name, MakeUnique<Texture>(image));
+	}
+
+	Texture& ResourceManager::StoreMipmapped(const String& name, UniquePtr<Texture> texture)
+	{
 		// Bind texture and generate mipmaps
-		glBindTexture(GL_TEXTURE_2D, texture->GetID());
+		GLStateCache::Get().BindTexture(0, texture->GetID());
 
 		glGenerateMipmap(GL_TEXTURE_2D);
 
@@ -87,10 +104,49 @@ namespace Nyx
 		return *(m_textures[name]);
 	}
 
+	SharedPtr<const Mesh> ResourceManager::GetMesh(MeshKind kind, uint32 resolution)
+	{
+		uint64 key = (uint64(kind) << 32) | resolution;
+
+		WeakPtr<const Mesh>& cached = m_meshes[key];
+		if (SharedPtr<const Mesh> mesh = cached.lock())
+			return mesh;
+
+		Mesh* mesh = nullptr;
+		switch (kind)
+		{
+		case MeshKind::SPHERE:
+			mesh = new Mesh(MeshBuilder::CreateSphere(resolution));
+			break;
+		case MeshKind::QUAD:
+			mesh = new Mesh(MeshBuilder::CreateQuad());
+			break;
+		}
+
+		spdlog::info("Built mesh (kind {}, resolution {})", uint32(kind), resolution);
+
+		SharedPtr<const Mesh> shared(mesh, [](const Mesh* released)
+		{
+			MeshBuilder::Destroy(*released);
+			delete released;
+		});
+
+		cached = shared;
+		return shared;
+	}
+
+	usize ResourceManager::GetLiveMeshCount()
+	{
+		return std::count_if(m_meshes.begin(), m_meshes.end(), [](const auto& entry) { return !entry.second.expired(); });
+	}
+
 	void ResourceManager::Clear()
 	{
 		spdlog::info("Clearing all cached resources");
 		m_shaders.clear();
 		m_textures.clear();
+
+		// Meshes still held by spheres stay alive; only the lookup is dropped
+		m_meshes.clear();
 	}
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <Application/Constants/Constants.h>
 #include <Application/Resource/Material/ShaderProgram/ShaderProgram.h>
 #include <Application/Resource/Material/Texture/Texture.h>
+#include <Application/Resource/Buffers/Mesh.h>
+#include <Application/Utils/TextureUtils/TextureLoader.h>
 
 namespace Nyx
 {
@@ -13,11 +15,24 @@ namespace Nyx
 		static Shader& GetShader(const String& name, const String& vertexPath = "", const String& fragmentPath = "");
 		static Texture& GetTexture(const String& name, const String& texturePath = "");
 		static Texture& GetMipmappedTexture(const String& name, const String& texturePath = "");
+
+		// Main-thread half of a parallel load: the pixels were decoded elsewhere
+		static Texture& AddMipmappedTexture(const String& name, const TextureData& image);
+		static bool8 HasTexture(const String& name) { return m_textures.contains(name); }
+
+		// Built on first use and freed with its last holder; later requests share the same buffers.
+		// Fixed shapes such as QUAD ignore the resolution.
+		static SharedPtr<const Mesh> GetMesh(MeshKind kind, uint32 resolution = 0);
+		static usize GetLiveMeshCount();
+
 		static void Clear();
 
 	private:
+		static Texture& StoreMipmapped(const String& name, UniquePtr<Texture> texture);
+
 		static inline HashMap<String, UniquePtr<Shader>> m_shaders;
 		static inline HashMap<String, UniquePtr<Texture>> m_textures;
+		static inline HashMap<uint64, WeakPtr<const Mesh>> m_meshes; // (kind << 32) | resolution
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,606 @@
+#include "SceneLoader.h"
+#include "SceneManager.h"
+
+#include <spdlog/spdlog.h>
+
+#include <Application/Core/Services/ResourceLocator/ResourceLocator.h>
+#include <Application/Core/Services/Generation/OrbitGenerator.h>
+#include <Application/Core/Services/Scheduler/ThreadPool.h>
+#include <Application/Utils/TextureUtils/TextureLoader.h>
+
+namespace Nyx
+{
+	namespace
+	{
+		enum class BlockType { NONE, BODY, CAMERA, LIGHT, BELT };
+		enum class OrbitType { NONE, CIRCULAR, ELEMENTS };
+
+		// Fields of the block being parsed; only the ones matching its type are used
+		struct Block
+		{
+			BlockType type = BlockType::NONE;
+			String name;
+			uint32 line = 0;
+
+			float64 mass = 0.0;
+			float64 radius = 1.0;
+			Math::Vec3f position = Math::Vec3f(0.0f);
+			Math::Vec3f velocity = Math::Vec3f(0.0f);
+			float32 tilt = 0.0f;
+			float32 spin = 0.0f;
+			SphereDesc sphere;
+			String texture;
+
+			OrbitType orbit = OrbitType::NONE;
+			String parent;
+			float64 distance = 0.0;
+			bool8 tidallyLocked = false;
+			OrbitalElements elements;
+
+			String frame; // parent whose frame this body is rigidly attached to
+
+			LightComponent light{ LightType::POINT, Math::Vec3f(1.0f), 1.0f, Position(), Math::Vec3f(0.0f, -1.0f, 0.0f), 0.0f, 0.0f };
+			String attach;
+
+			PopulationDesc population;
+		};
+
+		struct TextureJob
+		{
+			String path;
+			TextureData image;
+			String error;
+		};
+
+		struct PendingSphere
+		{
+			EntityID entityID;
+			SphereDesc desc;
+			String texture;
+		};
+
+		struct PendingOrbit
+		{
+			EntityID satelliteID;
+			EntityID attractorID;
+			OrbitType type;
+			bool8 tidallyLocked;
+			OrbitalElements elements;
+		};
+
+		struct PendingBelt
+		{
+			String name;
+			EntityID attractorID;
+			PopulationDesc population;
+			SphereDesc desc;
+			String texture;
+		};
+
+		bool8 ReadVec3(StringStream& tokens, Math::Vec3f& out)
+		{
+			return static_cast<bool8>(tokens >> out.x >> out.y >> out.z);
+		}
+
+		// "uniform lo hi", "normal mean sigma", "rayleigh sigma", "powerlaw lo hi exponent" or a
+		// plain number, optionally followed by "clamp min max"
+		bool8 ReadDistribution(StringStream& tokens, Distribution& out)
+		{
+			String kind;
+			if (!(tokens >> kind))
+				return false;
+
+			bool8 ok = true;
+			if (kind == "uniform")
+			{
+				out.type = DistributionType::UNIFORM;
+				ok = static_cast<bool8>(tokens >> out.a >> out.b);
+			}
+			else if (kind == "normal")
+			{
+				out.type = DistributionType::NORMAL;
+				ok = static_cast<bool8>(tokens >> out.a >> out.b);
+			}
+			else if (kind == "rayleigh")
+			{
+				out.type = DistributionType::RAYLEIGH;
+				ok = static_cast<bool8>(tokens >> out.a);
+			}
+			else if (kind == "powerlaw")
+			{
+				out.type = DistributionType::POWER_LAW;
+				ok = static_cast<bool8>(tokens >> out.a >> out.b >> out.c) && out.a > 0.0 && out.b > out.a;
+			}
+			else
+			{
+				StringStream number(kind);
+				out.type = DistributionType::CONSTANT;
+				ok = static_cast<bool8>(number >> out.a);
+			}
+
+			String clamp;
+			if (ok && (tokens >> clamp))
+				ok = clamp == "clamp" && static_cast<bool8>(tokens >> out.min >> out.max);
+
+			return ok;
+		}
+
+		String ReadRest(StringStream& tokens)
+		{
+			String rest;
+			std::getline(tokens >> std::ws, rest);
+
+			while (!rest.empty() && std::isspace(static_cast<uint8>(rest.back())))
+				rest.pop_back();
+
+			return rest;
+		}
+
+		class SceneParser
+		{
+		public:
+			SceneParser(Scene& scene, const String& path, bool8 withGraphics) : m_scene(scene), m_path(path), m_withGraphics(withGraphics) {}
+
+			void ParseLine(String line, uint32 lineNumber)
+			{
+				m_lineNumber = lineNumber;
+
+				usize comment = line.find('#');
+				if (comment != String::npos)
+					line.resize(comment);
+
+				StringStream tokens(line);
+				String keyword;
+				if (!(tokens >> keyword))
+					return;
+
+				if (keyword == "end")
+				{
+					Commit();
+					return;
+				}
+
+				if (keyword == "body" || keyword == "camera" || keyword == "light" || keyword == "belt")
+				{
+					if (m_block.type != BlockType::NONE)
+					{
+						Warn("'" + keyword + "' inside an open block, closing '" + m_block.name + "' first");
+						Commit();
+					}
+
+					m_block = Block{};
+					m_block.type = keyword == "body" ? BlockType::BODY
+						: keyword == "camera" ? BlockType::CAMERA
+						: keyword == "light" ? BlockType::LIGHT
+						: BlockType::BELT;
+
+					// Belts are drawn in bulk; keep their shared mesh light
+					if (m_block.type == BlockType::BELT)
+						m_block.sphere.res = 8;
+
+					m_block.line = lineNumber;
+					m_block.name = ReadRest(tokens);
+
+					if (m_block.name.empty())
+						m_block.name = keyword;
+					return;
+				}
+
+				if (m_block.type == BlockType::NONE)
+				{
+					Warn("'" + keyword + "' outside of a block");
+					return;
+				}
+
+				if (!SetField(keyword, tokens))
+					Warn("invalid or unknown field '" + keyword + "'");
+			}
+
+			void Finish()
+			{
+				if (m_block.type != BlockType::NONE)
+				{
+					Warn("missing 'end' for '" + m_block.name + "'");
+					Commit();
+				}
+
+				m_decoders.Wait();
+
+				// GL work has to stay on this thread
+				for (auto& [name, job] : m_textures)
+				{
+					if (!job->error.empty())
+					{
+						spdlog::error("{}: texture '{}' failed to load: {}", m_path, name, job->error);
+						continue;
+					}
+
+					ResourceManager::AddMipmappedTexture(name, job->image);
+					TextureLoader::Free(job->image);
+				}
+
+				ECS& world = m_scene.GetWorld();
+				if (m_withGraphics)
+				{
+					for (PendingSphere& pending : m_spheres)
+					{
+						if (!pending.texture.empty() && ResourceManager::HasTexture(pending.texture))
+							pending.desc.texture = &ResourceManager::GetMipmappedTexture(pending.texture);
+
+						world.AddComponent(pending.entityID, Sphere{ pending.desc });
+					}
+				}
+
+				// Applied in file order, so a moon sees its planet's final velocity
+				for (const PendingOrbit& orbit : m_orbits)
+				{
+					if (orbit.type == OrbitType::CIRCULAR)
+						InitializeCircularOrbit(world, orbit.satelliteID, orbit.attractorID, 0.0, orbit.tidallyLocked);
+					else
+						InitializeKeplerianOrbit(world, orbit.satelliteID, orbit.attractorID, orbit.elements);
+
+					if (orbit.type == OrbitType::ELEMENTS && orbit.tidallyLocked)
+						world.AddComponent(orbit.satelliteID, TidallyLocked{ orbit.attractorID });
+				}
+
+				// Last, so belts start from their attractor's final state
+				for (PendingBelt& belt : m_belts)
+				{
+					EntityRange range;
+					if (m_withGraphics)
+					{
+						if (!belt.texture.empty() && ResourceManager::HasTexture(belt.texture))
+							belt.desc.texture = &ResourceManager::GetMipmappedTexture(belt.texture);
+
+						Sphere prototype{ belt.desc };
+						range = OrbitGenerator::Populate(m_scene, belt.attractorID, belt.population, &prototype);
+					}
+					else
+					{
+						range = OrbitGenerator::Populate(m_scene, belt.attractorID, belt.population, nullptr);
+					}
+
+					spdlog::info("Generated belt {}: {} bodies", belt.name, range.count);
+				}
+
+				spdlog::info("Loaded scene {}: {} bodies, {} belts, {} textures", m_path, m_spheres.size(), m_belts.size(), m_textures.size());
+			}
+
+		private:
+			bool8 SetField(const String& key, StringStream& tokens)
+			{
+				Block& b = m_block;
+
+				if (b.type == BlockType::CAMERA)
+				{
+					if (key == "position")
+						return ReadVec3(tokens, b.position);
+					return false;
+				}
+
+				if (b.type == BlockType::LIGHT)
+				{
+					if (key == "type")
+					{
+						String type;
+						tokens >> type;
+
+						if (type == "point")
+							b.light.type = LightType::POINT;
+						else if (type == "directional")
+							b.light.type = LightType::DIRECTIONAL;
+						else if (type == "spot")
+							Warn("spot lights are not supported; '" + b.name + "' keeps its type");
+						else
+							return false;
+						return true;
+					}
+					if (key == "attach")
+						return !(b.attach = ReadRest(tokens)).empty();
+					if (key == "position")
+						return ReadVec3(tokens, b.position);
+					if (key == "direction")
+						return ReadVec3(tokens, b.light.direction);
+					if (key == "color")
+						return ReadVec3(tokens, b.light.color);
+					if (key == "intensity")
+						return static_cast<bool8>(tokens >> b.light.intensity);
+					if (key == "range")
+						return static_cast<bool8>(tokens >> b.light.range);
+					if (key == "decay")
+						return static_cast<bool8>(tokens >> b.light.decay);
+					return false;
+				}
+
+				if (b.type == BlockType::BELT)
+				{
+					PopulationDesc& p = b.population;
+
+					if (key == "attractor")
+						return !(b.parent = ReadRest(tokens)).empty();
+					if (key == "count")
+						return static_cast<bool8>(tokens >> p.count);
+					if (key == "seed")
+						return static_cast<bool8>(tokens >> p.seed);
+					if (key == "semimajor")
+						return ReadDistribution(tokens, p.semiMajorAxis);
+					if (key == "eccentricity")
+						return ReadDistribution(tokens, p.eccentricity);
+					if (key == "inclination")
+						return ReadDistribution(tokens, p.inclination);
+					if (key == "mass")
+						return ReadDistribution(tokens, p.mass);
+					if (key == "radius")
+						return ReadDistribution(tokens, p.radius);
+					if (key == "align")
+						return (p.alignToAttractor = true);
+					return SetMaterialField(key, tokens);
+				}
+
+				if (key == "mass")
+					return static_cast<bool8>(tokens >> b.mass);
+				if (key == "radius")
+					return static_cast<bool8>(tokens >> b.radius);
+				if (key == "position")
+					return ReadVec3(tokens, b.position);
+				if (key == "velocity")
+					return ReadVec3(tokens, b.velocity);
+				if (key == "tilt")
+					return static_cast<bool8>(tokens >> b.tilt);
+				if (key == "spin")
+					return static_cast<bool8>(tokens >> b.spin);
+				if (key == "parent")
+					return !(b.frame = ReadRest(tokens)).empty();
+				if (key == "orbit")
+				{
+					if (!(tokens >> b.parent >> b.distance))
+						return false;
+
+					String flag;
+					b.tidallyLocked = (tokens >> flag) && flag == "locked";
+					b.orbit = OrbitType::CIRCULAR;
+					return true;
+				}
+				if (key == "elements")
+				{
+					OrbitalElements& e = b.elements;
+					if (!(tokens >> b.parent >> e.semiMajorAxis >> e.eccentricity >> e.inclination >> e.ascendingNode >> e.argumentOfPeriapsis >> e.trueAnomaly))
+						return false;
+
+					String flag;
+					b.tidallyLocked = (tokens >> flag) && flag == "locked";
+					b.orbit = OrbitType::ELEMENTS;
+					return true;
+				}
+
+				return SetMaterialField(key, tokens);
+			}
+
+			bool8 SetMaterialField(const String& key, StringStream& tokens)
+			{
+				Block& b = m_block;
+
+				if (key == "resolution")
+					return static_cast<bool8>(tokens >> b.sphere.res);
+				if (key == "color")
+					return ReadVec3(tokens, b.sphere.baseColor);
+				if (key == "emissive")
+					return ReadVec3(tokens, b.sphere.emissiveColor) && static_cast<bool8>(tokens >> b.sphere.emissiveStrength);
+				if (key == "texture")
+				{
+					String path;
+					tokens >> b.texture;
+					path = ReadRest(tokens);
+
+					if (b.texture.empty())
+						return false;
+
+					RequestTexture(b.texture, path);
+					return true;
+				}
+
+				return false;
+			}
+
+			void Commit()
+			{
+				switch (m_block.type)
+				{
+				case BlockType::BODY:   CommitBody(); break;
+				case BlockType::CAMERA: m_scene.CreateCamera(m_block.name, Transform{ Position(m_block.position), Rotation(), Scale() }); break;
+				case BlockType::LIGHT:  CommitLight(); break;
+				case BlockType::BELT:   CommitBelt(); break;
+				default: Warn("'end' without an open block"); break;
+				}
+
+				m_block = Block{};
+			}
+
+			void CommitBody()
+			{
+				Block& b = m_block;
+
+				EntityID parentID = NO_ID;
+				if (b.orbit != OrbitType::NONE)
+				{
+					auto it = m_bodies.find(b.parent);
+					if (it == m_bodies.end())
+					{
+						Warn("'" + b.name + "' orbits unknown body '" + b.parent + "'; parents must come first");
+						b.orbit = OrbitType::NONE;
+					}
+					else
+					{
+						parentID = it->second;
+					}
+				}
+
+				ECS& world = m_scene.GetWorld();
+
+				if (!b.frame.empty())
+				{
+					CommitAttachedBody();
+					return;
+				}
+
+				// Circular orbits start on the parent's +X axis, like the old hard-coded setup
+				if (b.orbit == OrbitType::CIRCULAR)
+					b.position = world.ReadComponent<Transform>(parentID)->position.GetWorld() + Math::Vec3f(b.distance, 0.0, 0.0);
+
+				Transform transform{ Position(b.position), Rotation(0.0, 0.0, glm::radians(b.tilt)), Scale(b.radius) };
+				Velocity angularVelocity = LocalToWorld(Math::Vec3f(0.0, b.spin, 0.0), transform);
+
+				EntityID entityID = m_scene.CreateEmptyEntity(b.name);
+				world.AddComponent(entityID, transform);
+				world.AddComponent(entityID, Rigidbody{ b.mass, angularVelocity, Velocity(b.velocity), Acceleration() });
+
+				if (m_bodies.contains(b.name))
+					Warn("duplicate body name '" + b.name + "'; later references use the newest");
+				m_bodies[b.name] = entityID;
+
+				// Meshes wait for the decoded textures
+				m_spheres.push_back(PendingSphere{ entityID, b.sphere, b.texture });
+
+				if (b.orbit != OrbitType::NONE)
+					m_orbits.push_back(PendingOrbit{ entityID, parentID, b.orbit, b.tidallyLocked, b.elements });
+			}
+
+			// Rigidly attached to a parent (rings, stations): no rigidbody, the transform system places it
+			void CommitAttachedBody()
+			{
+				Block& b = m_block;
+
+				auto it = m_bodies.find(b.frame);
+				if (it == m_bodies.end())
+				{
+					Warn("'" + b.name + "' has unknown parent '" + b.frame + "'; parents must come first");
+					return;
+				}
+
+				ECS& world = m_scene.GetWorld();
+				Transform local{ Position(b.position), Rotation(0.0, 0.0, glm::radians(b.tilt)), Scale(b.radius) };
+
+				Transform transform = local;
+				transform.position.SetWorld(world.ReadComponent<Transform>(it->second)->position.GetWorld() + b.position);
+
+				EntityID entityID = m_scene.CreateEmptyEntity(b.name);
+				world.AddComponent(entityID, transform);
+				world.AddComponent(entityID, Hierarchy{ it->second, local });
+
+				m_bodies[b.name] = entityID;
+				m_spheres.push_back(PendingSphere{ entityID, b.sphere, b.texture });
+			}
+
+			void CommitBelt()
+			{
+				Block& b = m_block;
+
+				auto it = m_bodies.find(b.parent);
+				if (it == m_bodies.end())
+				{
+					Warn("belt '" + b.name + "' needs a known 'attractor'");
+					return;
+				}
+
+				if (b.population.semiMajorAxis.type == DistributionType::CONSTANT && b.population.semiMajorAxis.a <= 0.0)
+				{
+					Warn("belt '" + b.name + "' needs a 'semimajor' distribution");
+					return;
+				}
+
+				m_belts.push_back(PendingBelt{ b.name, it->second, b.population, b.sphere, b.texture });
+			}
+
+			void CommitLight()
+			{
+				Block& b = m_block;
+
+				if (b.attach.empty())
+				{
+					m_scene.CreateLight(b.name, Transform{ Position(b.position), Rotation(), Scale() }, b.light);
+					return;
+				}
+
+				auto it = m_bodies.find(b.attach);
+				if (it == m_bodies.end())
+				{
+					Warn("light '" + b.name + "' attached to unknown body '" + b.attach + "'");
+					return;
+				}
+
+				m_scene.GetWorld().AddComponent(it->second, b.light);
+			}
+
+			void RequestTexture(const String& name, const String& path)
+			{
+				if (!m_withGraphics || ResourceManager::HasTexture(name) || m_textures.contains(name))
+					return;
+
+				if (path.empty())
+				{
+					Warn("texture '" + name + "' is not loaded and has no path");
+					return;
+				}
+
+				UniquePtr<TextureJob>& job = m_textures[name];
+				job = MakeUnique<TextureJob>();
+				job->path = ResourceLocator::Get(path);
+
+				TextureJob* target = job.get();
+				m_decoders.Submit([target]()
+				{
+					try
+					{
+						target->image = TextureLoader::Load(target->path, false);
+					}
+					catch (const std::exception& e)
+					{
+						target->error = e.what();
+					}
+				});
+			}
+
+			void Warn(const String& message)
+			{
+				spdlog::warn("{}:{}: {}", m_path, m_lineNumber, message);
+			}
+
+			Scene& m_scene;
+			String m_path;
+			bool8 m_withGraphics;
+			uint32 m_lineNumber = 0;
+
+			Block m_block;
+			HashMap<String, EntityID> m_bodies;
+			HashMap<String, UniquePtr<TextureJob>> m_textures;
+			Vector<PendingSphere> m_spheres;
+			Vector<PendingOrbit> m_orbits;
+			Vector<PendingBelt> m_belts;
+
+			// Declared last so it is joined before the jobs it writes into are freed
+			ThreadPool m_decoders;
+		};
+	}
+
+	bool8 SceneLoader::Load(Scene& scene, const String& path, bool8 withGraphics)
+	{
+		String fullPath = ResourceLocator::Get(path);
+
+		IfStream file(fullPath);
+		if (!file.is_open())
+		{
+			spdlog::error("Could not open scene file: {}", fullPath);
+			return false;
+		}
+
+		SceneParser parser(scene, path, withGraphics);
+
+		String line;
+		uint32 lineNumber = 0;
+		while (std::getline(file, line))
+			parser.ParseLine(line, ++lineNumber);
+
+		parser.Finish();
+		return true;
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+
+namespace Nyx
+{
+	class Scene;
+
+	// Builds a scene from a plain-text description (see Assets/Scenes/SolarSystem.nyxscene).
+	// The file is streamed one line at a time and entities are created as each block closes.
+	// Textures are handed to worker threads for decoding as soon as they are named, so image
+	// decoding overlaps parsing; GL uploads and sphere meshes follow on the calling thread.
+	// Without graphics, no textures or spheres are created, so no GL context is needed.
+	class SceneLoader
+	{
+	public:
+		// Returns false if the file could not be opened; bad lines are logged and skipped
+		static bool8 Load(Scene& scene, const String& path, bool8 withGraphics = true);
+	};
+}
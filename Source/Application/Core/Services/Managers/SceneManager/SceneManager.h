@@ -2,6 +2,7 @@
 
 #include <Application/Core/Core.h>
 #include <Application/Core/Services/Managers/EntityManager/EntityManager.h>
+#include <Application/Core/Services/Managers/SceneManager/SceneLoader.h>
 #include <Application/Resource/Components/Components.h>
 #include <Application/Core/Services/Lighting/LightingSystem.h>
 #include <Application/Resource/Components/Mesh/GridMesh/GridMesh.h>
@@ -14,65 +15,39 @@ namespace Nyx
 	using SceneID = uint32;
 	using CameraID = uint32;
 
-	class SceneObject
+	// Consecutive entities created in one batch
+	struct EntityRange
 	{
-	public:
-		SceneObject(String name)
-		{
-			m_entityID = ECS::Get().CreateEntity();
-			ECS::Get().AddComponent(m_entityID, Name{ name });
-		}
-
-		~SceneObject()
-		{
-			ECS::Get().DestroyEntity(m_entityID);
-		}
-
-		EntityID GetEntityID()
-		{
-			return m_entityID;
-		}
-
-		void Draw(const Camera& camera, const Transform& cameraTransform)
-		{
-			const auto& transform = ECS::Get().GetComponent<Transform>(m_entityID);
-			if (!transform)
-				return;
-
-			// Scale it down for rendering purposes
-			auto pos = transform->position / METERS_PER_UNIT;
-			auto sca = transform->scale / METERS_PER_UNIT;
-			auto rot = transform->rotation;
-
-			const Position& cameraPos = cameraTransform.position;
-			Math::Vec3f relPos = Math::Vec3f(pos.GetWorld() - cameraPos.GetWorld());
-
-			Math::Mat4f model = glm::translate(Math::Mat4f(1.0f), relPos) * rot.ToMatrix() * sca.ToMatrix();
-			Math::Mat4f view = camera.GetViewMatrix();
-			Math::Mat4f projection = camera.GetProjectionMatrix();
-
-			Math::Mat4f mvp = projection * view * model;
-
-			if (ECS::Get().HasComponent<Sphere>(m_entityID))
-			{
-				const auto& sphere = ECS::Get().GetComponent<Sphere>(m_entityID);
-				sphere->DrawSphere(model, view, projection);
-			}
-		}
-
-	private:
-		EntityID m_entityID;
+		EntityID first = NO_ID;
+		uint32 count = 0;
 	};
 
+	// Entities live in the scene's world and are released together with it
 	class Scene 
 	{
 	public:
-		Scene() = default;
+		Scene() : m_world(MakeUnique<ECS>()) {}
 		~Scene() = default;
 
+		Scene(const Scene&) = delete;
+		Scene& operator=(const Scene&) = delete;
+		Scene(Scene&&) = default;
+		Scene& operator=(Scene&&) = default;
+
+		// Independent copy of the whole world, e.g. for prediction or parameter sweeps
+		Scene Clone() const
+		{
+			Scene scene(m_world->Clone());
+			scene.m_activeCameraID = m_activeCameraID;
+			return scene;
+		}
+
+		ECS& GetWorld() { return *m_world; }
+		const ECS& GetWorld() const { return *m_world; }
+
 		CameraID GetActiveCameraID() const
 		{
-			if (m_activeCameraID != NO_ID && ECS::Get().HasComponent<Camera>(m_activeCameraID))
+			if (m_activeCameraID != NO_ID && m_world->HasComponent<Camera>(m_activeCameraID))
 				return m_activeCameraID;
 
 			return NO_ID;
@@ -80,68 +55,76 @@ namespace Nyx
 
 		EntityID CreateEmptyEntity(String name)
 		{
-			SharedPtr<SceneObject> obj = MakeShared<SceneObject>(name);
-
-			m_sceneObjectPtrs[obj->GetEntityID()] = obj;
-			return obj->GetEntityID();
+			EntityID entityID = m_world->CreateEntity();
+			m_world->AddComponent(entityID, Name{ name });
+			return entityID;
 		}
 
 		EntityID CreatePlanet(String name, const Transform& transform, const Rigidbody& rigidbody, const SphereDesc& sphereDesc)
 		{
-			SharedPtr<SceneObject> obj = MakeShared<SceneObject>(name);
+			EntityID entityID = CreateEmptyEntity(name);
 
-			ECS::Get().AddComponent(obj->GetEntityID(), Sphere{sphereDesc});
-			ECS::Get().AddComponent(obj->GetEntityID(), transform);
-			ECS::Get().AddComponent(obj->GetEntityID(), rigidbody);
+			m_world->AddComponent(entityID, Sphere{sphereDesc});
+			m_world->AddComponent(entityID, transform);
+			m_world->AddComponent(entityID, rigidbody);
 
-			m_sceneObjectPtrs[obj->GetEntityID()] = obj;
-			return obj->GetEntityID();
+			return entityID;
 		}
 
 		EntityID CreateCamera(String name, const Transform& transform)
 		{
-			SharedPtr<SceneObject> obj = MakeShared<SceneObject>(name);
-			ECS::Get().AddComponent(obj->GetEntityID(), Camera{});
-			ECS::Get().AddComponent(obj->GetEntityID(), transform);
+			EntityID entityID = CreateEmptyEntity(name);
+			m_world->AddComponent(entityID, Camera{});
+			m_world->AddComponent(entityID, transform);
 
 			// Only set if valid
-			if (ECS::Get().HasComponent<Camera>(obj->GetEntityID()))
+			if (m_world->HasComponent<Camera>(entityID))
 			{
-				m_activeCameraID = obj->GetEntityID();
+				m_activeCameraID = entityID;
 			}
 			else 
 			{
 				m_activeCameraID = NO_ID;
 			}
 
-			m_sceneObjectPtrs[obj->GetEntityID()] = obj;
-			return obj->GetEntityID();
+			return entityID;
 		}
 
 		EntityID CreateLight(String name, const Transform& transform, LightComponent& lightParameters)
 		{
-			SharedPtr<SceneObject> obj = MakeShared<SceneObject>(name);
-			ECS::Get().AddComponent(obj->GetEntityID(), transform);
-			ECS::Get().AddComponent(obj->GetEntityID(), lightParameters);
+			EntityID entityID = CreateEmptyEntity(name);
+			m_world->AddComponent(entityID, transform);
+			m_world->AddComponent(entityID, lightParameters);
 
-			m_sceneObjectPtrs[obj->GetEntityID()] = obj;
-			return obj->GetEntityID();
+			return entityID;
 		}
 
-		SharedPtr<SceneObject> GetSceneObject(const EntityID& entityID)
+		// Batch path for large body counts: consecutive IDs, one growth step per pool and no
+		// name or mesh per body. Every body copies the prototype sphere, so they share its
+		// GPU mesh; without a prototype the bodies are only simulated.
+		EntityRange CreateBodies(Span<const Transform> transforms, Span<const Rigidbody> rigidbodies, const Sphere* prototype)
 		{
-			if (m_sceneObjectPtrs.find(entityID) != m_sceneObjectPtrs.end())
-				return m_sceneObjectPtrs[entityID];
+			assert(transforms.size() == rigidbodies.size());
 
-			spdlog::critical("SceneObject with given ID does not exist!");
-			return nullptr;
-		}
+			EntityRange range;
+			range.count = static_cast<uint32>(transforms.size());
+			if (range.count == 0)
+				return range;
 
-		uint32 GetSceneObjectSize() { return m_sceneObjectPtrs.size(); }
+			range.first = m_world->CreateEntities(range.count);
+			m_world->AddComponents<Transform>(range.first, transforms);
+			m_world->AddComponents<Rigidbody>(range.first, rigidbodies);
+			if (prototype != nullptr)
+				m_world->AddComponents<Sphere>(range.first, range.count, *prototype);
+
+			return range;
+		}
 
 	private:
+		Scene(UniquePtr<ECS> world) : m_world(std::move(world)) {}
+
+		UniquePtr<ECS> m_world;
 		CameraID m_activeCameraID = NO_ID;
-		HashMap<EntityID, SharedPtr<SceneObject>> m_sceneObjectPtrs;
 	};
 
 	class SceneManager 
@@ -159,13 +142,27 @@ namespace Nyx
 				return NO_ID;
 			}
 
-			Scene newScene;
-			m_scenes[sceneID] = newScene;
+			m_scenes.emplace(sceneID, Scene());
 			m_activeSceneID = sceneID;
 
 			return sceneID;
 		}
 
+		// Adds a deep copy of an existing scene; the active scene is left unchanged
+		SceneID CloneScene(SceneID sourceID)
+		{
+			Scene* source = GetScene(sourceID);
+			if (source == nullptr)
+				return NO_ID;
+
+			SceneID sceneID = 1;
+			while (m_scenes.contains(sceneID))
+				++sceneID;
+
+			m_scenes.emplace(sceneID, source->Clone());
+			return sceneID;
+		}
+
 		void DeleteScene(SceneID& id)
 		{
 			auto it = m_scenes.find(id);
@@ -204,157 +201,15 @@ namespace Nyx
 			return nullptr;
 		}
 
-		void GenerateEntities(SceneID& sceneID)
+		// Populates the scene from a scene description file, see SceneLoader
+		bool8 LoadScene(SceneID& sceneID, const String& path, bool8 withGraphics = true)
 		{
 			Scene* scenePtr = GetScene(sceneID);
 
 			if (scenePtr == nullptr)
-				return;
+				return false;
 
-			SphereDesc earthDesc;
-			earthDesc.texture = &ResourceManager::GetMipmappedTexture(
-				"EarthTexture",
-				R"(Nyx\Source\Assets\Textures\EarthTexture.jpg)"
-			);
-
-			SphereDesc moonDesc;
-			moonDesc.texture = &ResourceManager::GetMipmappedTexture(
-				"MoonTexture",
-				R"(Nyx\Source\Assets\Textures\MoonTexture.jpg)"
-			);
-
-			SphereDesc mercuryDesc;
-			mercuryDesc.texture = &ResourceManager::GetMipmappedTexture(
-				"MercuryTexture",
-				R"(Nyx\Source\Assets\Textures\MercuryTexture.jpg)"
-			);
-
-			SphereDesc venusDesc;
-			venusDesc.texture = &ResourceManager::GetMipmappedTexture(
-				"VenusTexture",
-				R"(Nyx\Source\Assets\Textures\VenusAtmosphere.jpg)"
-			);
-
-			SphereDesc marsDesc;
-			marsDesc.texture = &ResourceManager::GetMipmappedTexture(
-				"MarsTexture",
-				R"(Nyx\Source\Assets\Textures\MarsTexture.jpg)"
-			);
-
-			SphereDesc jupiterDesc;
-			jupiterDesc.texture = &ResourceManager::GetMipmappedTexture(
-				"JupiterTexture",
-				R"(Nyx\Source\Assets\Textures\JupiterTexture.jpg)"
-			);
-
-			SphereDesc saturnDesc;
-			saturnDesc.texture = &ResourceManager::GetMipmappedTexture(
-				"SaturnTexture",
-				R"(Nyx\Source\Assets\Textures\SaturnTexture.jpg)"
-			);
-
-			SphereDesc uranusDesc;
-			uranusDesc.texture = &ResourceManager::GetMipmappedTexture(
-				"UranusTexture",
-				R"(Nyx\Source\Assets\Textures\UranusTexture.jpg)"
-			);
-
-			SphereDesc neptuneDesc;
-			neptuneDesc.texture = &ResourceManager::GetMipmappedTexture(
-				"NeptuneTexture",
-				R"(Nyx\Source\Assets\Textures\NeptuneTexture.jpg)"
-			);
-
-			SphereDesc sunDesc;
-			sunDesc.emissiveColor = Math::Vec3f(1.0, 0.95, 0.8);
-			sunDesc.emissiveStrength = 1.0;
-			sunDesc.texture = &ResourceManager::GetMipmappedTexture(
-				"SunTexture",
-				R"(Nyx\Source\Assets\Textures\SunTexture.jpg)"
-			);
-
-			Position sunPosition(Math::Vec3f(0.0, 0.0, 0.0));
-			Position earthPosition(Math::Vec3f(AU, 0.0, 0.0));
-			Position moonPosition(Math::Vec3f(AU + EARTH_MOON_DISTANCE, 0.0, 0.0));
-			Position mercuryPosition(Math::Vec3f(MERCURY_SUN_DISTANCE, 0.0, 0.0));
-			Position venusPosition(Math::Vec3f(VENUS_SUN_DISTANCE, 0.0, 0.0));
-			Position marsPosition(Math::Vec3f(MARS_SUN_DISTANCE, 0.0, 0.0));
-			Position jupiterPosition(Math::Vec3f(JUPITER_SUN_DISTANCE, 0.0, 0.0));
-			Position saturnPosition(Math::Vec3f(SATURN_SUN_DISTANCE, 0.0, 0.0));
-			Position uranusPosition(Math::Vec3f(URANUS_SUN_DISTANCE, 0.0, 0.0));
-			Position neptunePosition(Math::Vec3f(NEPTUNE_SUN_DISTANCE, 0.0, 0.0));
-
-			Rotation sunRotation(0.0, 0.0, 0.0);
-			Rotation earthRotation(0.0, 0.0, glm::radians(EARTH_INCLINATION));
-			Rotation moonRotation(0.0, 0.0, 0.0);
-			Rotation mercuryRotation(0.0, 0.0, glm::radians(MERCURY_INCLINATION));
-			Rotation venusRotation(0.0, 0.0, glm::radians(VENUS_INCLINATION));
-			Rotation marsRotation(0.0, 0.0, glm::radians(MARS_INCLINATION));
-			Rotation jupiterRotation(0.0, 0.0, glm::radians(JUPITER_INCLINATION));
-			Rotation saturnRotation(0.0, 0.0, glm::radians(SATURN_INCLINATION));
-			Rotation uranusRotation(0.0, 0.0, glm::radians(URANUS_INCLINATION));
-			Rotation neptuneRotation(0.0, 0.0, glm::radians(NEPTUNE_INCLINATION));
-
-			Scale earthSize(EARTH_EQUATORAL_RADIUS);
-			Scale moonSize(MOON_EQUATORAL_RADIUS);
-			Scale sunSize(SUN_RADIUS);
-			Scale mercurySize(MERCURY_EQUATORAL_RADIUS);
-			Scale venusSize(VENUS_EQUATORAL_RADIUS);
-			Scale marsSize(MARS_EQUATORAL_RADIUS);
-			Scale jupiterSize(JUPITER_EQUATORAL_RADIUS);
-			Scale saturnSize(SATURN_EQUATORAL_RADIUS);
-			Scale uranusSize(URANUS_EQUATORAL_RADIUS);
-			Scale neptuneSize(NEPTUNE_EQUATORAL_RADIUS);
-
-			Transform earthTransform = Transform{ earthPosition, earthRotation, earthSize };
-			Transform moonTransform = Transform{ moonPosition, moonRotation, moonSize };
-			Transform sunTransform = Transform{ sunPosition, sunRotation, sunSize };
-			Transform mercuryTransform = Transform{ mercuryPosition, mercuryRotation, mercurySize };
-			Transform venusTransform = Transform{ venusPosition, venusRotation, venusSize };
-			Transform marsTransform = Transform{ marsPosition, marsRotation, marsSize };
-			Transform jupiterTransform = Transform{ jupiterPosition, jupiterRotation, jupiterSize };
-			Transform saturnTransform = Transform{ saturnPosition, saturnRotation, saturnSize };
-			Transform uranusTransform = Transform{ uranusPosition, uranusRotation, uranusSize };
-			Transform neptuneTransform = Transform{ neptunePosition, neptuneRotation, neptuneSize };
-
-			Velocity earthAngularVelocity = LocalToWorld(Math::Vec3f(0.0, EARTH_ANGULAR_VELOCITY_RADIANS, 0.0), earthTransform);
-			Velocity mercuryAngularVelocity = LocalToWorld(Math::Vec3f(0.0, MERCURY_ANGULAR_VELOCITY_RADIANS, 0.0), mercuryTransform);
-			Velocity venusAngularVelocity = LocalToWorld(Math::Vec3f(0.0, VENUS_ANGULAR_VELOCITY_RADIANS, 0.0), venusTransform);
-			Velocity marsAngularVelocity = LocalToWorld(Math::Vec3f(0.0, MARS_ANGULAR_VELOCITY_RADIANS, 0.0), marsTransform);
-			Velocity jupiterAngularVelocity = LocalToWorld(Math::Vec3f(0.0, JUPITER_ANGULAR_VELOCITY_RADIANS, 0.0), jupiterTransform);
-			Velocity saturnAngularVelocity = LocalToWorld(Math::Vec3f(0.0, SATURN_ANGULAR_VELOCITY_RADIANS, 0.0), saturnTransform);
-			Velocity uranusAngularVelocity = LocalToWorld(Math::Vec3f(0.0, URANUS_ANGULAR_VELOCITY_RADIANS, 0.0), uranusTransform);
-			Velocity neptuneAngularVelocity = LocalToWorld(Math::Vec3f(0.0, NEPTUNE_ANGULAR_VELOCITY_RADIANS, 0.0), neptuneTransform);
-
-			EntityID cameraID = scenePtr->CreateCamera("Camera", Transform{ Math::Vec3f(AU / METERS_PER_UNIT, 0.0f, 10.0f) });
-			EntityID sunID = scenePtr->CreatePlanet("Sun", sunTransform, Rigidbody{ SUN_MASS }, sunDesc);
-			EntityID mercuryID = scenePtr->CreatePlanet("Mercury", mercuryTransform, Rigidbody{ MERCURY_MASS , mercuryAngularVelocity }, mercuryDesc);
-			EntityID venusID = scenePtr->CreatePlanet("Venus", venusTransform, Rigidbody{ VENUS_MASS, venusAngularVelocity }, venusDesc);
-			EntityID earthID = scenePtr->CreatePlanet("Earth", earthTransform, Rigidbody{ EARTH_MASS , earthAngularVelocity }, earthDesc);
-			EntityID moonID = scenePtr->CreatePlanet("Moon", moonTransform, Rigidbody{ MOON_MASS }, moonDesc);
-			EntityID marsID = scenePtr->CreatePlanet("Mars", marsTransform, Rigidbody{ MARS_MASS, marsAngularVelocity }, marsDesc);
-			EntityID jupiterID = scenePtr->CreatePlanet("Jupiter", jupiterTransform, Rigidbody{ JUPITER_MASS, jupiterAngularVelocity }, jupiterDesc);
-			EntityID saturnID = scenePtr->CreatePlanet("Saturn", saturnTransform, Rigidbody{ SATURN_MASS, saturnAngularVelocity }, saturnDesc);
-			EntityID uranusID = scenePtr->CreatePlanet("Uranus", uranusTransform, Rigidbody{ URANUS_MASS, uranusAngularVelocity }, uranusDesc);
-			EntityID neptuneID = scenePtr->CreatePlanet("Neptune", neptuneTransform, Rigidbody{ NEPTUNE_MASS, neptuneAngularVelocity }, neptuneDesc);
-
-			LightComponent pointLight;
-			pointLight.type = LightType::POINT;
-			pointLight.color = Math::Vec3f(1.0, 1.0, 1.0);
-			pointLight.intensity = 1.0;
-			pointLight.range = SOL_SYSTEM_RADIUS;
-			pointLight.decay = 1 / SOL_SYSTEM_RADIUS;
-			ECS::Get().AddComponent(sunID, pointLight);
-
-			InitializeCircularOrbit(mercuryID, sunID, 0.0);
-			InitializeCircularOrbit(venusID, sunID, 0.0);
-			InitializeCircularOrbit(earthID, sunID, 0.0);
-			InitializeCircularOrbit(moonID, earthID, 0.0, true);
-			InitializeCircularOrbit(marsID, sunID, 0.0);
-			InitializeCircularOrbit(jupiterID, sunID, 0.0);
-			InitializeCircularOrbit(saturnID, sunID, 0.0);
-			InitializeCircularOrbit(uranusID, sunID, 0.0);
-			InitializeCircularOrbit(neptuneID, sunID, 0.0);
+			return SceneLoader::Load(*scenePtr, path, withGraphics);
 		}
 
 	private:
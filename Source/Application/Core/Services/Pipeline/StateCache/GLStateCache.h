@@ -0,0 +1,136 @@
+#pragma once
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <Application/Core/Core.h>
+
+namespace Nyx
+{
+	// CPU-side shadow of the GL state the renderer changes. Every setter compares against the
+	// shadow and only calls GL when the value differs, so runs of similar draws issue no state
+	// calls and nothing ever has to be read back with glGet. All binds and state changes must go
+	// through here; after foreign code such as the ImGui backend touches GL, call Invalidate so
+	// the next setter of each state is sent unconditionally.
+	class GLStateCache : public Singleton<GLStateCache>
+	{
+	public:
+		static constexpr uint32 TEXTURE_UNITS = 16;
+
+		void SetDepthTest(bool8 enabled) { SetCapability(GL_DEPTH_TEST, m_depthTest, enabled); }
+		void SetBlend(bool8 enabled) { SetCapability(GL_BLEND, m_blend, enabled); }
+		void SetCullFace(bool8 enabled) { SetCapability(GL_CULL_FACE, m_cullFace, enabled); }
+
+		void SetDepthFunc(GLenum func)
+		{
+			if (Changed(m_depthFunc, func))
+				glDepthFunc(func);
+		}
+
+		void SetDepthMask(bool8 write)
+		{
+			if (Changed(m_depthMask, write ? 1 : 0))
+				glDepthMask(write ? GL_TRUE : GL_FALSE);
+		}
+
+		void SetBlendFunc(GLenum src, GLenum dst)
+		{
+			if (Changed(m_blendSrc, src) | Changed(m_blendDst, dst))
+				glBlendFunc(src, dst);
+		}
+
+		void SetCullMode(GLenum mode)
+		{
+			if (Changed(m_cullMode, mode))
+				glCullFace(mode);
+		}
+
+		void UseProgram(uint32 program)
+		{
+			if (Changed(m_program, program))
+				glUseProgram(program);
+		}
+
+		void BindVertexArray(uint32 vao)
+		{
+			if (Changed(m_vertexArray, vao))
+				glBindVertexArray(vao);
+		}
+
+		void ActiveTexture(uint32 unit)
+		{
+			if (Changed(m_activeUnit, unit))
+				glActiveTexture(GL_TEXTURE0 + unit);
+		}
+
+		// Binds to GL_TEXTURE_2D of `unit`, which also becomes the active unit
+		void BindTexture(uint32 unit, uint32 texture)
+		{
+			ActiveTexture(unit);
+			if (Changed(m_textures[unit], texture))
+				glBindTexture(GL_TEXTURE_2D, texture);
+		}
+
+		// Deleted objects may have their names reused; forget them so a rebind is not skipped
+		void ForgetVertexArray(uint32 vao) { if (m_vertexArray == int64(vao)) m_vertexArray = UNKNOWN; }
+		void ForgetTexture(uint32 texture)
+		{
+			for (int64& bound : m_textures)
+			{
+				if (bound == int64(texture))
+					bound = UNKNOWN;
+			}
+		}
+
+		void Invalidate()
+		{
+			m_depthTest = m_blend = m_cullFace = UNKNOWN;
+			m_depthFunc = m_depthMask = m_blendSrc = m_blendDst = m_cullMode = UNKNOWN;
+			m_program = m_vertexArray = m_activeUnit = UNKNOWN;
+
+			for (int64& texture : m_textures)
+				texture = UNKNOWN;
+		}
+
+		// Calls sent and skipped since the last ResetStats
+		uint64 GetIssuedCount() const { return m_issued; }
+		uint64 GetSkippedCount() const { return m_skipped; }
+		void ResetStats() { m_issued = m_skipped = 0; }
+
+	private:
+		// No GL value is negative, so this never matches a real one
+		static constexpr int64 UNKNOWN = -1;
+
+		bool8 Changed(int64& shadow, int64 value)
+		{
+			if (shadow == value)
+			{
+				++m_skipped;
+				return false;
+			}
+
+			shadow = value;
+			++m_issued;
+			return true;
+		}
+
+		void SetCapability(GLenum capability, int64& shadow, bool8 enabled)
+		{
+			if (Changed(shadow, enabled ? 1 : 0))
+				enabled ? glEnable(capability) : glDisable(capability);
+		}
+
+		int64 m_depthTest = UNKNOWN, m_blend = UNKNOWN, m_cullFace = UNKNOWN;
+		int64 m_depthFunc = UNKNOWN, m_depthMask = UNKNOWN;
+		int64 m_blendSrc = UNKNOWN, m_blendDst = UNKNOWN;
+		int64 m_cullMode = UNKNOWN;
+
+		int64 m_program = UNKNOWN;
+		int64 m_vertexArray = UNKNOWN;
+		int64 m_activeUnit = UNKNOWN;
+		int64 m_textures[TEXTURE_UNITS] = { UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN,
+											UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN };
+
+		uint64 m_issued = 0;
+		uint64 m_skipped = 0;
+	};
+}
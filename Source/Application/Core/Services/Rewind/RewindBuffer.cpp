@@ -0,0 +1,341 @@
+#include "RewindBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+#include <Application/Constants/Constants.h>
+#include <Application/Core/Physics/Physics.h>
+#include <Application/Resource/Components/Components.h>
+
+namespace Nyx
+{
+	namespace
+	{
+		static_assert(std::is_trivially_copyable_v<Transform> && std::is_trivially_copyable_v<Rigidbody>,
+			"Rewind samples are raw copies of the simulation components");
+
+		constexpr usize BODY_SIZE = sizeof(EntityID) + sizeof(Transform) + sizeof(Rigidbody);
+
+		// Zero runs shorter than this are cheaper to keep inside a literal
+		constexpr usize MIN_ZERO_RUN = 3;
+
+		void WriteVarint(Vector<uint8>& out, usize value)
+		{
+			while (value >= 0x80)
+			{
+				out.push_back(static_cast<uint8>(value) | 0x80);
+				value >>= 7;
+			}
+			out.push_back(static_cast<uint8>(value));
+		}
+
+		bool8 ReadVarint(const Vector<uint8>& in, usize& offset, usize& value)
+		{
+			value = 0;
+			for (uint32 shift = 0; offset < in.size() && shift < 64; shift += 7)
+			{
+				uint8 byte = in[offset++];
+				value |= usize(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+					return true;
+			}
+			return false;
+		}
+
+		uint32 CountOf(const Vector<uint8>& state)
+		{
+			uint32 count = 0;
+			if (state.size() >= sizeof(uint32))
+				std::memcpy(&count, state.data(), sizeof(uint32));
+			return count;
+		}
+	}
+
+	void RewindBuffer::Capture(ECS& world, float32 deltaTime)
+	{
+		if (&world != m_world)
+		{
+			Clear();
+			m_world = &world;
+		}
+
+		// Physics skips paused frames, so they are not part of the timeline either
+		if (TIME_SCALE == 0.0f)
+			return;
+
+		m_deltaTime = deltaTime;
+		++m_frame;
+		m_time += float64(deltaTime) * TIME_SCALE;
+
+		// First step after a restore: everything recorded beyond this point is a stale future
+		if (!m_samples.empty() && m_samples.back().frame >= m_frame)
+			DropFrom(m_frame);
+
+		m_headFrame = m_frame;
+		m_headTime = m_time;
+
+		if (!m_samples.empty())
+		{
+			Sample& last = m_samples.back();
+			bool8 scaleChanged = last.timeScale != 0.0f && last.timeScale != TIME_SCALE;
+
+			// Re-integration needs one time scale per interval, so a change closes it early
+			if (!scaleChanged && m_frame - last.frame < m_settings.captureInterval)
+			{
+				last.timeScale = TIME_SCALE;
+				return;
+			}
+		}
+
+		Gather(world, m_scratch);
+
+		Sample sample;
+		sample.frame = m_frame;
+		sample.time = m_time;
+		sample.keyframe = m_samples.empty()
+			|| m_sinceKeyframe + 1 >= m_settings.keyframeInterval
+			|| m_scratch.size() != m_previous.size();
+
+		if (sample.keyframe)
+		{
+			sample.data = m_scratch;
+			m_sinceKeyframe = 0;
+		}
+		else
+		{
+			EncodeDelta(m_previous, m_scratch, sample.data);
+			++m_sinceKeyframe;
+		}
+
+		m_memoryUsage += sample.data.size();
+		m_samples.push_back(std::move(sample));
+		std::swap(m_previous, m_scratch);
+
+		EnforceBudget();
+	}
+
+	bool8 RewindBuffer::Restore(ECS& world, float64 time)
+	{
+		if (&world != m_world || m_samples.empty() || time < m_samples.front().time || time > m_headTime)
+			return false;
+
+		// Last sample at or before the requested time
+		auto it = std::upper_bound(m_samples.begin(), m_samples.end(), time,
+			[](float64 value, const Sample& sample) { return value < sample.time; });
+		usize index = static_cast<usize>(it - m_samples.begin()) - 1;
+		const Sample& sample = m_samples[index];
+
+		Vector<uint8> state;
+		if (!Reconstruct(index, state))
+		{
+			spdlog::error("Rewind sample at frame {} could not be decoded", sample.frame);
+			return false;
+		}
+
+		Apply(world, state);
+
+		uint64 frame = sample.frame;
+		float64 current = sample.time;
+
+		// Step the rest of the way with the scale that was in effect at the time
+		uint64 lastFrame = index + 1 < m_samples.size() ? m_samples[index + 1].frame - 1 : m_headFrame;
+		if (sample.timeScale != 0.0f && frame < lastFrame)
+		{
+			float32 liveScale = TIME_SCALE;
+			TIME_SCALE = sample.timeScale;
+
+			float64 step = float64(m_deltaTime) * TIME_SCALE;
+			while (frame < lastFrame && current + step <= time)
+			{
+				Physics::Update(world, m_deltaTime);
+				current += step;
+				++frame;
+			}
+
+			TIME_SCALE = liveScale;
+		}
+
+		m_frame = frame;
+		m_time = current;
+
+		// Deltas recorded from here on are taken against this sample
+		m_previous = std::move(state);
+		m_sinceKeyframe = 0;
+		for (usize i = index; !m_samples[i].keyframe; --i)
+			++m_sinceKeyframe;
+
+		return true;
+	}
+
+	void RewindBuffer::Clear()
+	{
+		m_world = nullptr;
+		m_samples.clear();
+		m_previous.clear();
+		m_memoryUsage = 0;
+		m_sinceKeyframe = 0;
+		m_frame = 0;
+		m_time = 0.0;
+		m_headFrame = 0;
+		m_headTime = 0.0;
+	}
+
+	void RewindBuffer::Gather(ECS& world, Vector<uint8>& out)
+	{
+		// Only what Physics::Update integrates
+		Vector<EntityID> ids = world.View<Sphere, Transform, Rigidbody>();
+		uint32 count = static_cast<uint32>(ids.size());
+
+		out.resize(sizeof(uint32) + count * BODY_SIZE);
+		uint8* cursor = out.data();
+
+		std::memcpy(cursor, &count, sizeof(uint32));
+		cursor += sizeof(uint32);
+
+		// One array per field keeps unchanged fields in long zero runs once XORed
+		std::memcpy(cursor, ids.data(), count * sizeof(EntityID));
+		cursor += count * sizeof(EntityID);
+
+		for (EntityID id : ids)
+		{
+			std::memcpy(cursor, world.ReadComponent<Transform>(id), sizeof(Transform));
+			cursor += sizeof(Transform);
+		}
+
+		for (EntityID id : ids)
+		{
+			std::memcpy(cursor, world.ReadComponent<Rigidbody>(id), sizeof(Rigidbody));
+			cursor += sizeof(Rigidbody);
+		}
+	}
+
+	void RewindBuffer::Apply(ECS& world, const Vector<uint8>& state)
+	{
+		uint32 count = CountOf(state);
+
+		const uint8* ids = state.data() + sizeof(uint32);
+		const uint8* transforms = ids + count * sizeof(EntityID);
+		const uint8* rigidbodies = transforms + count * sizeof(Transform);
+
+		for (uint32 i = 0; i < count; ++i)
+		{
+			EntityID id;
+			std::memcpy(&id, ids + i * sizeof(EntityID), sizeof(EntityID));
+
+			// Bodies destroyed since the sample was taken are not brought back
+			if (!world.HasComponent<Transform>(id) || !world.HasComponent<Rigidbody>(id))
+				continue;
+
+			std::memcpy(world.GetComponent<Transform>(id), transforms + i * sizeof(Transform), sizeof(Transform));
+			std::memcpy(world.GetComponent<Rigidbody>(id), rigidbodies + i * sizeof(Rigidbody), sizeof(Rigidbody));
+		}
+	}
+
+	// Pairs of (zero run, literal length) as varints, each followed by its literal bytes
+	void RewindBuffer::EncodeDelta(const Vector<uint8>& previous, const Vector<uint8>& current, Vector<uint8>& out)
+	{
+		out.clear();
+
+		usize size = current.size();
+		usize i = 0;
+
+		while (i < size)
+		{
+			usize zeroStart = i;
+			while (i < size && previous[i] == current[i])
+				++i;
+
+			usize literalStart = i;
+			usize zeros = 0;
+			while (i < size && zeros < MIN_ZERO_RUN)
+			{
+				zeros = previous[i] == current[i] ? zeros + 1 : 0;
+				++i;
+			}
+
+			usize literalEnd = i - zeros;
+			i = literalEnd;
+
+			WriteVarint(out, literalStart - zeroStart);
+			WriteVarint(out, literalEnd - literalStart);
+			for (usize j = literalStart; j < literalEnd; ++j)
+				out.push_back(previous[j] ^ current[j]);
+		}
+
+		out.shrink_to_fit();
+	}
+
+	bool8 RewindBuffer::DecodeDelta(const Vector<uint8>& delta, Vector<uint8>& state)
+	{
+		usize offset = 0;
+		usize position = 0;
+
+		while (offset < delta.size())
+		{
+			usize zeros, literal;
+			if (!ReadVarint(delta, offset, zeros) || !ReadVarint(delta, offset, literal))
+				return false;
+
+			position += zeros;
+			if (position + literal > state.size() || offset + literal > delta.size())
+				return false;
+
+			for (usize j = 0; j < literal; ++j)
+				state[position + j] ^= delta[offset + j];
+
+			position += literal;
+			offset += literal;
+		}
+
+		return position <= state.size();
+	}
+
+	bool8 RewindBuffer::Reconstruct(usize index, Vector<uint8>& state) const
+	{
+		usize keyframe = index;
+		while (!m_samples[keyframe].keyframe)
+			--keyframe;
+
+		state = m_samples[keyframe].data;
+
+		for (usize i = keyframe + 1; i <= index; ++i)
+		{
+			if (!DecodeDelta(m_samples[i].data, state))
+				return false;
+		}
+
+		return state.size() == sizeof(uint32) + CountOf(state) * BODY_SIZE;
+	}
+
+	void RewindBuffer::DropFrom(uint64 frame)
+	{
+		while (!m_samples.empty() && m_samples.back().frame >= frame)
+		{
+			m_memoryUsage -= m_samples.back().data.size();
+			m_samples.pop_back();
+		}
+	}
+
+	void RewindBuffer::EnforceBudget()
+	{
+		while (GetMemoryUsage() > m_settings.memoryBudget)
+		{
+			// Evict whole keyframe groups; deltas are useless without their keyframe
+			auto next = std::find_if(m_samples.begin() + 1, m_samples.end(),
+				[](const Sample& sample) { return sample.keyframe; });
+
+			if (next == m_samples.end())
+			{
+				// Only one group left: start a new one so it can go next time
+				m_sinceKeyframe = m_settings.keyframeInterval;
+				return;
+			}
+
+			for (auto it = m_samples.begin(); it != next; ++it)
+				m_memoryUsage -= it->data.size();
+
+			m_samples.erase(m_samples.begin(), next);
+		}
+	}
+}
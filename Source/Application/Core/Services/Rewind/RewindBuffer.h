@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+#include <Application/Core/Services/Managers/EntityManager/EntityManager.h>
+
+namespace Nyx
+{
+	struct RewindSettings
+	{
+		usize memoryBudget = 64ull << 20;
+		uint32 captureInterval = 4;  // frames between samples
+		uint32 keyframeInterval = 32; // samples between full keyframes
+	};
+
+	// Recent history of the integrated state (Transform and Rigidbody of every simulated body)
+	// for scrubbing back in time. Samples are taken every few frames; every Nth one is a full
+	// keyframe and the rest are XOR deltas against the previous sample, zero-run encoded, so
+	// components that did not move cost almost nothing. The oldest keyframe and its deltas are
+	// dropped when the budget is exceeded.
+	//
+	// Restoring decodes the nearest sample at or before the requested time and re-runs the
+	// physics step for the remaining frames, which reproduces the recorded run exactly because
+	// a sample is forced whenever the time scale changes. Samples past the restored point stay
+	// available until the simulation advances again, at which point the timeline forks.
+	class RewindBuffer : public Singleton<RewindBuffer>
+	{
+	public:
+		// Called once per frame after physics
+		void Capture(ECS& world, float32 deltaTime);
+
+		// Returns false if the time is outside the buffered range
+		bool8 Restore(ECS& world, float64 time);
+
+		void Clear();
+
+		float64 GetTime() const { return m_time; }
+		float64 GetOldestTime() const { return m_samples.empty() ? m_time : m_samples.front().time; }
+		float64 GetNewestTime() const { return m_headTime; }
+
+		usize GetSampleCount() const { return m_samples.size(); }
+		usize GetMemoryUsage() const { return m_memoryUsage + m_previous.size(); }
+
+		RewindSettings& GetSettings() { return m_settings; }
+
+	private:
+		struct Sample
+		{
+			uint64 frame = 0;
+			float64 time = 0.0;
+			float32 timeScale = 0.0f; // of the frames up to the next sample; 0 until one is taken
+			bool8 keyframe = false;
+			Vector<uint8> data; // raw state for keyframes, encoded XOR otherwise
+		};
+
+		// [count][ids][transforms][rigidbodies]
+		static void Gather(ECS& world, Vector<uint8>& out);
+		static void Apply(ECS& world, const Vector<uint8>& state);
+
+		static void EncodeDelta(const Vector<uint8>& previous, const Vector<uint8>& current, Vector<uint8>& out);
+		static bool8 DecodeDelta(const Vector<uint8>& delta, Vector<uint8>& state);
+
+		// Rebuilds the raw state of a sample from the keyframe that precedes it
+		bool8 Reconstruct(usize index, Vector<uint8>& state) const;
+
+		void DropFrom(uint64 frame);
+		void EnforceBudget();
+
+		RewindSettings m_settings;
+		ECS* m_world = nullptr;
+
+		Vector<Sample> m_samples;
+		Vector<uint8> m_previous; // raw state of the newest sample
+		Vector<uint8> m_scratch;
+		usize m_memoryUsage = 0;
+		uint32 m_sinceKeyframe = 0;
+
+		float32 m_deltaTime = 0.0f;
+
+		// Current position, which trails the recorded head after a restore
+		uint64 m_frame = 0;
+		float64 m_time = 0.0;
+		uint64 m_headFrame = 0;
+		float64 m_headTime = 0.0;
+	};
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Application/Core/Services/Rewind/RewindBuffer.h>
+#include <Application/Core/Services/Scheduler/System.h>
+
+namespace Nyx
+{
+	// Records the state Physics just produced; reading Rigidbody orders it after PhysicsSystem
+	class RewindSystem : public ISystem
+	{
+	public:
+		const char8* GetName() const override { return "Rewind"; }
+
+		void DeclareAccess(SystemAccess& access) const override
+		{
+			access.Reads<Sphere, Transform, Rigidbody>().Writes<RewindBuffer>();
+		}
+
+		void Update(const SystemContext& context) override
+		{
+			RewindBuffer::Get().Capture(*context.world, context.deltaTime);
+		}
+	};
+}
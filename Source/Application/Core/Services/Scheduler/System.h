@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+
+namespace Nyx
+{
+	class Scene;
+	class ECS;
+
+	struct SystemContext
+	{
+		Scene* scene = nullptr;
+		ECS* world = nullptr;
+		float32 deltaTime = 0.0f;
+	};
+
+	// Components (or shared services) a system touches. Two systems conflict when
+	// one writes something the other reads or writes; conflicting systems never overlap.
+	struct SystemAccess
+	{
+		Set<TypeIndex> reads;
+		Set<TypeIndex> writes;
+		bool8 mainThread = false;
+
+		template<typename... T>
+		SystemAccess& Reads()
+		{
+			(reads.insert(typeid(T)), ...);
+			return *this;
+		}
+
+		template<typename... T>
+		SystemAccess& Writes()
+		{
+			(writes.insert(typeid(T)), ...);
+			return *this;
+		}
+
+		// For systems that need the GL context
+		SystemAccess& RunOnMainThread()
+		{
+			mainThread = true;
+			return *this;
+		}
+
+		bool8 ConflictsWith(const SystemAccess& other) const
+		{
+			for (const TypeIndex& type : writes)
+			{
+				if (other.writes.contains(type) || other.reads.contains(type))
+					return true;
+			}
+
+			for (const TypeIndex& type : reads)
+			{
+				if (other.writes.contains(type))
+					return true;
+			}
+
+			return false;
+		}
+	};
+
+	class ISystem
+	{
+	public:
+		virtual ~ISystem() = default;
+
+		virtual const char8* GetName() const = 0;
+		virtual void DeclareAccess(SystemAccess& access) const = 0;
+		virtual void Update(const SystemContext& context) = 0;
+	};
+}
@@ -0,0 +1,135 @@
+#include "SystemScheduler.h"
+
+#include <chrono>
+
+namespace Nyx
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	static float64 ElapsedMs(Clock::time_point start)
+	{
+		return std::chrono::duration<float64, std::milli>(Clock::now() - start).count();
+	}
+
+	SystemScheduler::SystemScheduler(uint32 workerCount) : m_pool(workerCount) {}
+
+	void SystemScheduler::BuildGraph()
+	{
+		for (SystemNode& node : m_nodes)
+		{
+			node.dependents.clear();
+			node.dependencyCount = 0;
+		}
+
+		// Conflicting systems keep their registration order
+		for (uint32 i = 0; i < m_nodes.size(); ++i)
+		{
+			uint32 level = 0;
+
+			for (uint32 j = 0; j < i; ++j)
+			{
+				if (!m_nodes[i].access.ConflictsWith(m_nodes[j].access))
+					continue;
+
+				m_nodes[j].dependents.push_back(i);
+				++m_nodes[i].dependencyCount;
+				level = std::max(level, m_timings[j].level + 1);
+			}
+
+			m_timings[i].level = level;
+		}
+	}
+
+	void SystemScheduler::Run(const SystemContext& context)
+	{
+		Clock::time_point frameStart = Clock::now();
+
+		BuildGraph();
+
+		Vector<uint32> ready;
+		{
+			LockGuard<Mutex> lock(m_mutex);
+			m_context = &context;
+			m_remaining = static_cast<uint32>(m_nodes.size());
+
+			for (uint32 i = 0; i < m_nodes.size(); ++i)
+			{
+				m_nodes[i].pending = m_nodes[i].dependencyCount;
+				if (m_nodes[i].pending == 0)
+					ready.push_back(i);
+			}
+		}
+
+		for (uint32 index : ready)
+			Dispatch(index);
+
+		// The calling thread owns the GL context, so it drains main-thread systems itself
+		UniqueLock<Mutex> lock(m_mutex);
+		while (m_remaining > 0)
+		{
+			m_progress.wait(lock, [this]() { return m_remaining == 0 || !m_mainThreadQueue.empty(); });
+
+			while (!m_mainThreadQueue.empty())
+			{
+				uint32 index = m_mainThreadQueue.front();
+				m_mainThreadQueue.pop();
+
+				lock.unlock();
+				Execute(index);
+				lock.lock();
+			}
+		}
+
+		m_context = nullptr;
+		m_frameMs = ElapsedMs(frameStart);
+	}
+
+	void SystemScheduler::Dispatch(uint32 index)
+	{
+		if (m_nodes[index].access.mainThread)
+		{
+			{
+				LockGuard<Mutex> lock(m_mutex);
+				m_mainThreadQueue.push(index);
+			}
+
+			m_progress.notify_all();
+			return;
+		}
+
+		m_pool.Submit([this, index]() { Execute(index); });
+	}
+
+	void SystemScheduler::Execute(uint32 index)
+	{
+		SystemNode& node = m_nodes[index];
+
+		Clock::time_point start = Clock::now();
+		node.system->Update(*m_context);
+		float64 elapsed = ElapsedMs(start);
+
+		SystemTiming& timing = m_timings[index];
+		timing.lastMs = elapsed;
+		timing.averageMs = timing.averageMs == 0.0 ? elapsed : timing.averageMs * 0.95 + elapsed * 0.05;
+
+		Vector<uint32> ready;
+		{
+			LockGuard<Mutex> lock(m_mutex);
+			for (uint32 dependent : node.dependents)
+			{
+				if (--m_nodes[dependent].pending == 0)
+					ready.push_back(dependent);
+			}
+		}
+
+		for (uint32 dependent : ready)
+			Dispatch(dependent);
+
+		{
+			LockGuard<Mutex> lock(m_mutex);
+			--m_remaining;
+		}
+
+		m_progress.notify_all();
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+#include <Application/Core/Services/Scheduler/System.h>
+#include <Application/Core/Services/Scheduler/ThreadPool.h>
+
+namespace Nyx
+{
+	struct SystemTiming
+	{
+		String name;
+		uint32 level = 0;          // Depth in the dependency graph; equal levels may overlap
+		bool8 mainThread = false;
+		float64 lastMs = 0.0;
+		float64 averageMs = 0.0;
+	};
+
+	class SystemScheduler
+	{
+	public:
+		explicit SystemScheduler(uint32 workerCount = ThreadPool::DefaultThreadCount());
+
+		template<typename T, typename... Args>
+		T& Register(Args&&... args)
+		{
+			SystemNode node;
+			node.system = MakeUnique<T>(std::forward<Args>(args)...);
+			node.system->DeclareAccess(node.access);
+
+			SystemTiming timing;
+			timing.name = node.system->GetName();
+			timing.mainThread = node.access.mainThread;
+
+			T& system = static_cast<T&>(*node.system);
+			m_nodes.push_back(std::move(node));
+			m_timings.push_back(timing);
+			return system;
+		}
+
+		// Runs every registered system once, respecting declared access. Blocks until done.
+		void Run(const SystemContext& context);
+
+		const Vector<SystemTiming>& GetTimings() const { return m_timings; }
+		float64 GetFrameTimeMs() const { return m_frameMs; }
+		uint32 GetWorkerCount() const { return m_pool.GetThreadCount(); }
+
+	private:
+		struct SystemNode
+		{
+			UniquePtr<ISystem> system;
+			SystemAccess access;
+			Vector<uint32> dependents;
+			uint32 dependencyCount = 0;
+			uint32 pending = 0;
+		};
+
+		void BuildGraph();
+		void Dispatch(uint32 index);
+		void Execute(uint32 index);
+
+		Vector<SystemNode> m_nodes;
+		Vector<SystemTiming> m_timings;
+		ThreadPool m_pool;
+
+		Mutex m_mutex;
+		CondVar m_progress;
+		Queue<uint32> m_mainThreadQueue;
+		uint32 m_remaining = 0;
+		const SystemContext* m_context = nullptr;
+
+		float64 m_frameMs = 0.0;
+	};
+}
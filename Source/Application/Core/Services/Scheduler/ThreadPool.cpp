@@ -0,0 +1,76 @@
+#include "ThreadPool.h"
+
+namespace Nyx
+{
+	ThreadPool::ThreadPool(uint32 threadCount)
+	{
+		if (threadCount == 0)
+			threadCount = 1;
+
+		m_workers.reserve(threadCount);
+		for (uint32 i = 0; i < threadCount; ++i)
+			m_workers.emplace_back([this]() { WorkerLoop(); });
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			LockGuard<Mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+
+		m_taskAvailable.notify_all();
+
+		for (Thread& worker : m_workers)
+		{
+			if (worker.joinable())
+				worker.join();
+		}
+	}
+
+	void ThreadPool::Submit(voidFunc task)
+	{
+		{
+			LockGuard<Mutex> lock(m_mutex);
+			m_tasks.push(std::move(task));
+		}
+
+		m_taskAvailable.notify_one();
+	}
+
+	void ThreadPool::Wait()
+	{
+		UniqueLock<Mutex> lock(m_mutex);
+		m_allDone.wait(lock, [this]() { return m_tasks.empty() && m_activeTasks == 0; });
+	}
+
+	void ThreadPool::WorkerLoop()
+	{
+		while (true)
+		{
+			voidFunc task;
+
+			{
+				UniqueLock<Mutex> lock(m_mutex);
+				m_taskAvailable.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+
+				if (m_stopping && m_tasks.empty())
+					return;
+
+				task = std::move(m_tasks.front());
+				m_tasks.pop();
+				++m_activeTasks;
+			}
+
+			task();
+
+			{
+				LockGuard<Mutex> lock(m_mutex);
+				--m_activeTasks;
+
+				if (m_tasks.empty() && m_activeTasks == 0)
+					m_allDone.notify_all();
+			}
+		}
+	}
+}
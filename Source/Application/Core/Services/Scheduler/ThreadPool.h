@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+
+namespace Nyx
+{
+	class ThreadPool
+	{
+	public:
+		explicit ThreadPool(uint32 threadCount = DefaultThreadCount());
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		void Submit(voidFunc task);
+
+		// Blocks until every submitted task has finished
+		void Wait();
+
+		uint32 GetThreadCount() const { return static_cast<uint32>(m_workers.size()); }
+
+		// Leave one core for the main (GL) thread
+		static uint32 DefaultThreadCount()
+		{
+			uint32 cores = Thread::hardware_concurrency();
+			return cores > 1 ? cores - 1 : 1;
+		}
+
+	private:
+		void WorkerLoop();
+
+		Vector<Thread> m_workers;
+		Queue<voidFunc> m_tasks;
+
+		Mutex m_mutex;
+		CondVar m_taskAvailable;
+		CondVar m_allDone;
+
+		uint32 m_activeTasks = 0;
+		bool8 m_stopping = false;
+	};
+}
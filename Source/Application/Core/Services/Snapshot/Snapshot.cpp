@@ -0,0 +1,384 @@
+#include "Snapshot.h"
+
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+#include <Application/Resource/Components/Components.h>
+#include <Application/Resource/Components/Lighting/Light.h>
+#include <Application/Utils/FileUtils/MappedFile.h>
+
+namespace Nyx
+{
+	namespace
+	{
+		constexpr char8 MAGIC[4] = { 'N', 'Y', 'X', 'S' };
+		constexpr usize POOL_NAME_SIZE = 24;
+
+		struct FileHeader
+		{
+			char8 magic[4];
+			uint32 version;
+			uint32 nextID;
+			uint32 entityCount; // length of the alive array
+			uint32 freeCount;
+			uint32 poolCount;
+		};
+
+		struct PoolHeader
+		{
+			char8 name[POOL_NAME_SIZE];
+			uint32 count;
+			uint32 elementSize;
+			uint64 payloadSize;
+		};
+
+		// Bounds-checked cursor over the mapped file
+		struct Reader
+		{
+			const uint8* data;
+			usize size;
+			usize offset = 0;
+
+			const uint8* Take(uint64 bytes)
+			{
+				if (bytes > size - offset)
+					return nullptr;
+
+				const uint8* ptr = data + offset;
+				offset += bytes;
+				return ptr;
+			}
+
+			template<typename T>
+			bool8 Read(T& out)
+			{
+				const uint8* ptr = Take(sizeof(T));
+				if (ptr == nullptr)
+					return false;
+
+				std::memcpy(&out, ptr, sizeof(T));
+				return true;
+			}
+		};
+
+		void WriteBlock(OfStream& out, const char8* name, uint32 count, uint32 elementSize, const EntityID* entities, const void* payload, uint64 payloadSize)
+		{
+			PoolHeader header{};
+			std::strncpy(header.name, name, POOL_NAME_SIZE - 1);
+			header.count = count;
+			header.elementSize = elementSize;
+			header.payloadSize = payloadSize;
+
+			out.write(reinterpret_cast<const char8*>(&header), sizeof(header));
+			out.write(reinterpret_cast<const char8*>(entities), count * sizeof(EntityID));
+			out.write(static_cast<const char8*>(payload), payloadSize);
+		}
+
+		Vector<EntityID> CopyEntities(const uint8* data, uint32 count)
+		{
+			Vector<EntityID> entities(count);
+			if (count > 0)
+				std::memcpy(entities.data(), data, count * sizeof(EntityID));
+			return entities;
+		}
+	}
+
+	template<typename T>
+	Snapshot::PoolCodec Snapshot::RawCodec(const char8* name)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Raw snapshot pools must be trivially copyable");
+
+		PoolCodec codec;
+		codec.name = name;
+		codec.bit = ComponentTypes::Bit<T>();
+		codec.elementSize = sizeof(T);
+
+		codec.write = [name](const ECS& world, OfStream& out)
+		{
+			const ComponentPool<T>* pool = world.GetPool<T>();
+			uint32 count = pool != nullptr ? static_cast<uint32>(pool->ReadAll().size()) : 0;
+
+			WriteBlock(out, name, count, sizeof(T),
+				count > 0 ? pool->GetEntityIDs().data() : nullptr,
+				count > 0 ? pool->ReadAll().data() : nullptr,
+				uint64(count) * sizeof(T));
+		};
+
+		codec.decode = [](ECS& world, const PoolBlock& block, voidFunc& apply)
+		{
+			if (block.payloadSize != uint64(block.count) * sizeof(T))
+				return false;
+
+			// One bulk copy straight out of the mapping
+			Vector<T> values(block.count);
+			if (block.count > 0)
+				std::memcpy(static_cast<void*>(values.data()), block.payload, block.payloadSize);
+
+			apply = [&world, entities = CopyEntities(block.entities, block.count), values = std::move(values)]() mutable
+			{
+				ComponentPool<T>& pool = world.GetOrCreatePool<T>();
+				pool.Assign(std::move(entities), std::move(values), world.m_tick);
+
+				for (EntityID id : pool.GetEntityIDs())
+					world.m_signatures[id] |= ComponentTypes::Bit<T>();
+			};
+			return true;
+		};
+
+		return codec;
+	}
+
+	// Names are stored as a length-prefixed string per entity
+	Snapshot::PoolCodec Snapshot::NameCodec()
+	{
+		PoolCodec codec;
+		codec.name = "Name";
+		codec.bit = ComponentTypes::Bit<Name>();
+		codec.elementSize = 0;
+
+		codec.write = [](const ECS& world, OfStream& out)
+		{
+			const ComponentPool<Name>* pool = world.GetPool<Name>();
+			uint32 count = pool != nullptr ? static_cast<uint32>(pool->ReadAll().size()) : 0;
+
+			String payload;
+			for (uint32 i = 0; i < count; ++i)
+			{
+				const String& name = pool->ReadAll()[i].name;
+				uint32 length = static_cast<uint32>(name.size());
+
+				payload.append(reinterpret_cast<const char8*>(&length), sizeof(length));
+				payload.append(name);
+			}
+
+			WriteBlock(out, "Name", count, 0, count > 0 ? pool->GetEntityIDs().data() : nullptr, payload.data(), payload.size());
+		};
+
+		codec.decode = [](ECS& world, const PoolBlock& block, voidFunc& apply)
+		{
+			Reader reader{ block.payload, static_cast<usize>(block.payloadSize) };
+
+			Vector<Name> names(block.count);
+			for (Name& name : names)
+			{
+				uint32 length = 0;
+				if (!reader.Read(length))
+					return false;
+
+				const uint8* chars = reader.Take(length);
+				if (chars == nullptr)
+					return false;
+
+				name.name.assign(reinterpret_cast<const char8*>(chars), length);
+			}
+
+			apply = [&world, entities = CopyEntities(block.entities, block.count), names = std::move(names)]() mutable
+			{
+				ComponentPool<Name>& pool = world.GetOrCreatePool<Name>();
+				pool.Assign(std::move(entities), std::move(names), world.m_tick);
+
+				for (EntityID id : pool.GetEntityIDs())
+					world.m_signatures[id] |= ComponentTypes::Bit<Name>();
+			};
+			return true;
+		};
+
+		return codec;
+	}
+
+	const Vector<Snapshot::PoolCodec>& Snapshot::GetCodecs()
+	{
+		// Pool names are part of the file format; never rename them
+		static const Vector<PoolCodec> codecs = {
+			NameCodec(),
+			RawCodec<Transform>("Transform"),
+			RawCodec<Rigidbody>("Rigidbody"),
+			RawCodec<TidallyLocked>("TidallyLocked"),
+			RawCodec<Hierarchy>("Hierarchy"),
+			RawCodec<Massless>("Massless"),
+			RawCodec<LightComponent>("Light"),
+		};
+
+		return codecs;
+	}
+
+	bool8 Snapshot::Save(const ECS& world, const String& path)
+	{
+		assert(!world.IsDeferred() && "Cannot snapshot a world while its systems are running");
+
+		OfStream out(path, std::ios::binary | std::ios::trunc);
+		if (!out)
+		{
+			spdlog::error("Could not open {} for writing the snapshot", path);
+			return false;
+		}
+
+		const EntityManager& entities = world.m_entityManager;
+		const Vector<bool8>& alive = entities.GetAliveFlags();
+		const Vector<EntityID>& freeList = entities.GetFreeList();
+
+		FileHeader header{};
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.nextID = entities.GetNextID();
+		header.entityCount = static_cast<uint32>(alive.size());
+		header.freeCount = static_cast<uint32>(freeList.size());
+		header.poolCount = static_cast<uint32>(GetCodecs().size());
+		out.write(reinterpret_cast<const char8*>(&header), sizeof(header));
+
+		Vector<uint8> aliveBytes(alive.begin(), alive.end());
+		out.write(reinterpret_cast<const char8*>(aliveBytes.data()), aliveBytes.size());
+		out.write(reinterpret_cast<const char8*>(freeList.data()), freeList.size() * sizeof(EntityID));
+
+		for (const PoolCodec& codec : GetCodecs())
+			codec.write(world, out);
+
+		if (!out.good())
+		{
+			spdlog::error("Failed while writing the snapshot to {}", path);
+			return false;
+		}
+
+		spdlog::info("Saved snapshot of {} entities to {}", header.entityCount, path);
+		return true;
+	}
+
+	bool8 Snapshot::Load(ECS& world, const String& path)
+	{
+		assert(!world.IsDeferred() && "Cannot restore a world while its systems are running");
+
+		MappedFile file;
+		if (!file.Open(path))
+		{
+			spdlog::error("Could not map the snapshot {}", path);
+			return false;
+		}
+
+		Reader reader{ file.GetData(), file.GetSize() };
+
+		FileHeader header;
+		if (!reader.Read(header) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+		{
+			spdlog::error("{} is not a snapshot file", path);
+			return false;
+		}
+
+		if (header.version != VERSION)
+		{
+			spdlog::error("Snapshot {} has version {}, expected {}", path, header.version, VERSION);
+			return false;
+		}
+
+		const uint8* aliveBytes = reader.Take(header.entityCount);
+		const uint8* freeBytes = reader.Take(uint64(header.freeCount) * sizeof(EntityID));
+		if (aliveBytes == nullptr || freeBytes == nullptr)
+		{
+			spdlog::error("Snapshot {} is truncated", path);
+			return false;
+		}
+
+		// Decode everything first so a bad file never leaves the world half restored
+		const Vector<PoolCodec>& codecs = GetCodecs();
+		Vector<voidFunc> applies(codecs.size());
+		Vector<bool8> seen;
+
+		for (uint32 i = 0; i < header.poolCount; ++i)
+		{
+			PoolHeader poolHeader;
+			PoolBlock block;
+
+			if (!reader.Read(poolHeader)
+				|| (block.entities = reader.Take(uint64(poolHeader.count) * sizeof(EntityID))) == nullptr
+				|| (block.payload = reader.Take(poolHeader.payloadSize)) == nullptr)
+			{
+				spdlog::error("Snapshot {} is truncated", path);
+				return false;
+			}
+
+			block.count = poolHeader.count;
+			block.payloadSize = poolHeader.payloadSize;
+			poolHeader.name[POOL_NAME_SIZE - 1] = '\0';
+
+			auto it = std::find_if(codecs.begin(), codecs.end(), [&](const PoolCodec& codec) { return std::strcmp(codec.name, poolHeader.name) == 0; });
+			if (it == codecs.end())
+			{
+				spdlog::warn("Skipping unknown pool '{}' in snapshot {}", poolHeader.name, path);
+				continue;
+			}
+
+			if (poolHeader.elementSize != it->elementSize)
+			{
+				spdlog::error("Pool '{}' in snapshot {} has a different layout", poolHeader.name, path);
+				return false;
+			}
+
+			// Pools trust their entity list, so a repeated or out-of-range ID would leave the
+			// sparse and dense arrays disagreeing
+			seen.assign(header.entityCount, false);
+			for (uint32 e = 0; e < block.count; ++e)
+			{
+				EntityID id;
+				std::memcpy(&id, block.entities + e * sizeof(EntityID), sizeof(EntityID));
+				if (id >= header.entityCount)
+				{
+					spdlog::error("Pool '{}' in snapshot {} references entity {} out of range", poolHeader.name, path, id);
+					return false;
+				}
+
+				if (seen[id])
+				{
+					spdlog::error("Pool '{}' in snapshot {} lists entity {} more than once", poolHeader.name, path, id);
+					return false;
+				}
+				seen[id] = true;
+			}
+
+			if (!it->decode(world, block, applies[it - codecs.begin()]))
+			{
+				spdlog::error("Pool '{}' in snapshot {} is malformed", poolHeader.name, path);
+				return false;
+			}
+		}
+
+		// Pools missing from the file decode as empty, i.e. nothing of that type exists
+		for (size_t i = 0; i < codecs.size(); ++i)
+		{
+			if (!applies[i])
+				codecs[i].decode(world, PoolBlock{}, applies[i]);
+		}
+
+		Vector<bool8> alive(aliveBytes, aliveBytes + header.entityCount);
+		Vector<EntityID> freeList(header.freeCount);
+		if (!freeList.empty())
+			std::memcpy(freeList.data(), freeBytes, freeList.size() * sizeof(EntityID));
+
+		Signature serialized = 0;
+		for (const PoolCodec& codec : codecs)
+			serialized |= codec.bit;
+
+		// Render-side components survive only on entities the snapshot keeps alive
+		for (EntityID id = 0; id < world.m_signatures.size(); ++id)
+		{
+			Signature kept = world.m_signatures[id] & ~serialized;
+			if (kept == 0 || (id < alive.size() && alive[id]))
+				continue;
+
+			for (Signature bits = kept; bits != 0; bits &= bits - 1)
+				world.m_componentPools[std::countr_zero(bits)]->Remove(id, world.m_tick);
+		}
+
+		Vector<Signature> signatures(header.entityCount, 0);
+		for (EntityID id = 0; id < signatures.size() && id < world.m_signatures.size(); ++id)
+			signatures[id] = world.m_signatures[id] & ~serialized;
+
+		world.m_signatures = std::move(signatures);
+		world.m_entityManager.Restore(header.nextID, std::move(freeList), std::move(alive));
+
+		// Each apply swaps in its pool and sets the matching signature bits
+		for (voidFunc& apply : applies)
+			apply();
+
+		spdlog::info("Restored snapshot of {} entities from {}", header.entityCount, path);
+		return true;
+	}
+}
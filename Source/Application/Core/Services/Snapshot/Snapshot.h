@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+#include <Application/Core/Services/Managers/EntityManager/EntityManager.h>
+
+namespace Nyx
+{
+	// Versioned binary dump of a world's simulation state: entity allocation data plus
+	// every simulation pool as a dense array keyed by a stable name. Render-side pools
+	// (Sphere, Camera) are not stored; Load keeps them for entities that are still alive,
+	// so the intended restore path is "build the scene, then load the snapshot over it".
+	class Snapshot
+	{
+	public:
+		static constexpr uint32 VERSION = 1;
+
+		static bool8 Save(const ECS& world, const String& path);
+
+		// Leaves the world untouched if the file is missing or malformed
+		static bool8 Load(ECS& world, const String& path);
+
+	private:
+		struct PoolBlock
+		{
+			uint32 count = 0;
+			const uint8* entities = nullptr;
+			const uint8* payload = nullptr;
+			uint64 payloadSize = 0;
+		};
+
+		struct PoolCodec
+		{
+			const char8* name;
+			Signature bit;
+			uint32 elementSize; // 0 for variable-size encodings
+
+			function<void(const ECS&, OfStream&)> write;
+
+			// Decodes a block into owned arrays; `apply` later moves them into the world
+			function<bool8(ECS&, const PoolBlock&, voidFunc& apply)> decode;
+		};
+
+		static const Vector<PoolCodec>& GetCodecs();
+
+		template<typename T>
+		static PoolCodec RawCodec(const char8* name);
+		static PoolCodec NameCodec();
+	};
+}
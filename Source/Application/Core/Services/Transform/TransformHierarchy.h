@@ -0,0 +1,190 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+#include <Application/Core/Services/Managers/EntityManager/EntityManager.h>
+#include <Application/Resource/Components/Components.h>
+
+#include <spdlog/spdlog.h>
+
+namespace Nyx
+{
+	// World matrices for every entity with a Transform, stored contiguously in topological
+	// order (parents before children). Children carry a Hierarchy component; their world
+	// Transform is rebuilt from the parent's whenever either side changed. Clean subtrees
+	// are skipped. Each world owns one; reach it through ECS::GetResource.
+	class TransformHierarchy : public IWorldResource
+	{
+	public:
+		static constexpr uint32 INVALID_INDEX = std::numeric_limits<uint32>::max();
+
+		void Update(ECS& world)
+		{
+			uint64 tick = world.GetTick();
+
+			bool8 rebuild = tick < m_lastTick
+				|| world.GetPoolStructureVersion<Transform>() >= m_lastTick
+				|| world.GetPoolStructureVersion<Hierarchy>() >= m_lastTick
+				|| ParentsChanged(world);
+
+			if (rebuild)
+				Rebuild(world);
+
+			for (uint32 i = 0; i < m_order.size(); ++i)
+			{
+				EntityID id = m_order[i];
+				uint32 parent = m_parents[i];
+
+				bool8 dirty = rebuild;
+				if (!dirty && parent == INVALID_INDEX)
+					dirty = world.HasChangedSince<Transform>(id, m_lastTick);
+				else if (!dirty)
+					dirty = m_dirty[parent] || world.HasChangedSince<Hierarchy>(id, m_lastTick);
+
+				m_dirty[i] = dirty;
+				if (!dirty)
+					continue;
+
+				if (parent != INVALID_INDEX)
+					Compose(world, id, m_order[parent]);
+
+				const Transform& transform = *world.ReadComponent<Transform>(id);
+				m_worldMatrices[i] = glm::translate(Math::Mat4f(1.0f), transform.position.GetWorld())
+					* transform.rotation.ToMatrix()
+					* transform.scale.ToMatrix();
+			}
+
+			m_lastTick = tick;
+		}
+
+		bool8 Contains(EntityID id) const { return id < m_indexOf.size() && m_indexOf[id] != INVALID_INDEX; }
+
+		// In meters; only valid for entities that had a Transform at the last Update
+		const Math::Mat4f& GetWorldMatrix(EntityID id) const { return m_worldMatrices[m_indexOf[id]]; }
+
+		const Vector<EntityID>& GetOrder() const { return m_order; }
+		const Vector<Math::Mat4f>& GetWorldMatrices() const { return m_worldMatrices; }
+
+	private:
+		// Re-parenting keeps the pool shape, so compare against the recorded parents
+		bool8 ParentsChanged(ECS& world)
+		{
+			if (world.GetPoolVersion<Hierarchy>() < m_lastTick)
+				return false;
+
+			for (EntityID id : world.ChangedSince<Hierarchy>(m_lastTick))
+			{
+				if (!Contains(id))
+					return true;
+
+				uint32 parent = m_parents[m_indexOf[id]];
+				if (parent == INVALID_INDEX || m_order[parent] != world.ReadComponent<Hierarchy>(id)->parent)
+					return true;
+			}
+
+			return false;
+		}
+
+		void Rebuild(ECS& world)
+		{
+			m_order.clear();
+			m_parents.clear();
+			m_indexOf.clear();
+
+			if (world.GetComponentCount<Transform>() == 0)
+			{
+				m_worldMatrices.clear();
+				m_dirty.clear();
+				return;
+			}
+
+			const Vector<EntityID>& ids = world.GetAllComponentIDs<Transform>();
+
+			EntityID bound = 0;
+			for (EntityID id : ids)
+				bound = std::max(bound, id + 1);
+
+			m_indexOf.assign(bound, INVALID_INDEX);
+
+			// Children grouped by parent: counting sort into one flat array
+			Vector<uint32> childStart(bound + 1, 0);
+			Vector<EntityID> roots;
+
+			for (EntityID id : ids)
+			{
+				EntityID parent = ParentOf(world, id);
+				if (parent == id || !world.HasComponent<Transform>(parent))
+					roots.push_back(id);
+				else
+					++childStart[parent + 1];
+			}
+
+			for (EntityID i = 0; i < bound; ++i)
+				childStart[i + 1] += childStart[i];
+
+			Vector<EntityID> children(childStart[bound]);
+			Vector<uint32> fill(childStart.begin(), childStart.end() - 1);
+
+			for (EntityID id : ids)
+			{
+				EntityID parent = ParentOf(world, id);
+				if (parent != id && world.HasComponent<Transform>(parent))
+					children[fill[parent]++] = id;
+			}
+
+			// Breadth-first from the roots; whatever is left over sits in a cycle
+			m_order.reserve(ids.size());
+			for (EntityID root : roots)
+			{
+				m_indexOf[root] = static_cast<uint32>(m_order.size());
+				m_order.push_back(root);
+				m_parents.push_back(INVALID_INDEX);
+			}
+
+			for (uint32 i = 0; i < m_order.size(); ++i)
+			{
+				EntityID id = m_order[i];
+				for (uint32 c = childStart[id]; c < childStart[id + 1]; ++c)
+				{
+					m_indexOf[children[c]] = static_cast<uint32>(m_order.size());
+					m_order.push_back(children[c]);
+					m_parents.push_back(i);
+				}
+			}
+
+			if (m_order.size() != ids.size())
+				spdlog::error("Transform hierarchy has a cycle; {} entities are not updated", ids.size() - m_order.size());
+
+			m_worldMatrices.assign(m_order.size(), Math::Mat4f(1.0f));
+			m_dirty.assign(m_order.size(), true);
+		}
+
+		static EntityID ParentOf(ECS& world, EntityID id)
+		{
+			return world.HasComponent<Hierarchy>(id) ? world.ReadComponent<Hierarchy>(id)->parent : id;
+		}
+
+		// Child world = parent frame (translation and rotation only) * local
+		static void Compose(ECS& world, EntityID childID, EntityID parentID)
+		{
+			const Transform& parent = *world.ReadComponent<Transform>(parentID);
+			const Transform& local = world.ReadComponent<Hierarchy>(childID)->local;
+			Transform& transform = *world.GetComponent<Transform>(childID);
+
+			Math::Quatf parentRotation = parent.rotation.GetQuaternion();
+
+			transform.position.SetWorld(parent.position.GetWorld() + parentRotation * local.position.GetWorld());
+			transform.rotation.SetQuaternion(parentRotation * local.rotation.GetQuaternion());
+			transform.scale = local.scale;
+		}
+
+		uint64 m_lastTick = 0;
+
+		// Parallel arrays in topological order
+		Vector<EntityID> m_order;
+		Vector<uint32> m_parents; // index into m_order
+		Vector<Math::Mat4f> m_worldMatrices;
+		Vector<bool8> m_dirty;
+
+		Vector<uint32> m_indexOf; // EntityID -> index into m_order
+	};
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <Application/Core/Services/Transform/TransformHierarchy.h>
+#include <Application/Core/Services/Scheduler/System.h>
+
+namespace Nyx
+{
+	class TransformSystem : public ISystem
+	{
+	public:
+		const char8* GetName() const override { return "Transform"; }
+
+		void DeclareAccess(SystemAccess& access) const override
+		{
+			access.Reads<Hierarchy>().Writes<Transform, TransformHierarchy>();
+		}
+
+		void Update(const SystemContext& context) override
+		{
+			context.world->GetResource<TransformHierarchy>().Update(*context.world);
+		}
+	};
+}
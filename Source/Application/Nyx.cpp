@@ -1,5 +1,6 @@
 #pragma once
 #include <iostream>
+#include <charconv>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -16,6 +17,9 @@
 #include <Application/Core/Services/Input/InputDispatcher.h>
 #include <Application/Core/Services/Managers/SceneManager/SceneManager.h>
 #include <Application/Core/Services/ResourceLocator/ResourceLocator.h>
+#include <Application/Core/Services/Input/InputRecorder.h>
+#include <Application/Core/Services/Ensemble/EnsembleRunner.h>
+#include <Application/Utils/StatsUtils/StatsUtils.h>
 
 using namespace Nyx;
 
@@ -23,21 +27,83 @@ int main(int argc, char** argv)
 {
     ResourceLocator::Initialize(argv[0]);
 
+    // --ecs-stats <frames>: log pool memory every N frames, e.g. to watch long runs for leaks
+    // --record <file> / --replay <file>: capture a session, or play one back and exit when it ends
+    // --ensemble <file>: run perturbed copies of the scene headless and exit (see EnsembleRunner)
+    uint32 statsInterval = 0;
+    String recordPath;
+    String replayPath;
+    String ensemblePath;
+    String ensembleWorker;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (String(argv[i]) == "--ecs-stats")
+        {
+            StringView value = argv[i + 1];
+            auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), statsInterval);
+            if (error != std::errc() || end != value.data() + value.size())
+            {
+                spdlog::error("--ecs-stats expects a frame count, got '{}'", value);
+                statsInterval = 0;
+            }
+        }
+        else if (String(argv[i]) == "--record")
+            recordPath = argv[i + 1];
+        else if (String(argv[i]) == "--replay")
+            replayPath = argv[i + 1];
+        else if (String(argv[i]) == "--ensemble")
+            ensemblePath = argv[i + 1];
+        else if (String(argv[i]) == "--ensemble-worker")
+            ensembleWorker = argv[i + 1];
+    }
+
+    String scenePath = R"(Nyx\Source\Assets\Scenes\SolarSystem.nyxscene)";
+
+    // Ensembles only simulate: no window, GL context or engine, and the scene is loaded without graphics
+    if (!ensemblePath.empty())
+    {
+        EnsembleDesc ensemble;
+        if (!EnsembleDesc::Load(ensemblePath, ensemble))
+            return -1;
+
+        SceneManager sceneManager;
+        SceneID sceneID = sceneManager.CreateScene();
+        if (!sceneManager.LoadScene(sceneID, ensemble.scene.empty() ? scenePath : ensemble.scene, false))
+            return -1;
+
+        ECS& world = sceneManager.GetActiveScene()->GetWorld();
+        if (!ensembleWorker.empty())
+            return EnsembleRunner::RunWorkerProcess(world, ensemble, ensembleWorker) ? 0 : -1;
+
+        return EnsembleRunner::Run(world, ensemble, FileSystem::absolute(argv[0]).string(), ensemblePath) ? 0 : -1;
+    }
+
     BasicWindow window;
     Engine engine(window.GetHandle());
     SceneManager sceneManager;
     SceneID sceneID = sceneManager.CreateScene();
     Scene& scene = *sceneManager.GetActiveScene();
 
-    sceneManager.GenerateEntities(sceneID);
+    sceneManager.LoadScene(sceneID, scenePath);
+
+    InputRecorder& recorder = InputRecorder::Get();
+    if (!replayPath.empty() && !recorder.StartReplay(scene.GetWorld(), replayPath))
+        return -1;
+    if (!recordPath.empty() && !recorder.StartRecording(scene.GetWorld(), recordPath))
+        return -1;
 
     window.Show();
-    while(window.IsActive())
+    uint64 frame = 0;
+    while(window.IsActive() && !recorder.IsFinished())
     {
         window.PollEvents();
         engine.Present(scene);
         window.SwapBuffers();
+
+        if (statsInterval > 0 && ++frame % statsInterval == 0)
+            spdlog::info("Frame {}\n{}", frame, FormatWorldStats(scene.GetWorld().GetStats()));
     }
+    recorder.Stop();
     window.Hide();
 
     return 0;
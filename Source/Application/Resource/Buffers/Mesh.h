@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Application/Resource/Buffers/VAO.h>
+#include <Application/Resource/Buffers/VBO.h>
+#include <Application/Resource/Buffers/EBO.h>
+
+namespace Nyx
+{
+	struct Mesh
+	{
+		VAO vao;
+		VBO vbo;
+		EBO ebo;
+	};
+
+	// Procedural meshes ResourceManager can build and share
+	enum class MeshKind : uint32
+	{
+		SPHERE,
+		QUAD
+	};
+}
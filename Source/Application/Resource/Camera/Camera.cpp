@@ -10,7 +10,6 @@
 #include <Application/Core/Services/Input/InputDispatcher.h>
 #include <Application/Core/Services/Input/InputEvent.h>
 #include <Application/Core/Services/Input/InputQueue.h>
-#include <Application/Core/Services/CameraService/CameraService.h>
 #include <Application/Resource/Components/Components.h>
 
 Camera::Camera()
@@ -25,89 +24,42 @@ Camera::Camera()
     SetWorldUp(Math::Vec3f(0.0f, 1.0f, 0.0f));
 
     UpdateCameraVectors();
+    UpdateMatrices();
 
     InputHelper::ProcessMouseButtons();
     InputHelper::ProcessMouseMovement();
     InputHelper::ProcessMouseScroll();
 }
 
-glm::mat4 Camera::GetViewMatrix() const
+bool8 Camera::UpdateMatrices()
 {
-    auto& cameraIDs = ECS::Get().GetAllComponentIDs<Camera>();
+    if (!m_dirty)
+        return false;
 
-    if (cameraIDs.size() <= 0)
-        return Math::Mat4d(0.0);
+    // Rendering is camera-relative, so the view only carries orientation
+    m_matrices.View = glm::lookAt(Math::Vec3f(0.0), GetFront(), GetUp());
+    m_matrices.Projection = glm::perspective(glm::radians(GetZoom()), GetAspectRatio(), GetNearPlane(), GetFarPlane());
+    m_matrices.ViewProjection = m_matrices.Projection * m_matrices.View;
 
-    const EntityID& id = cameraIDs[0];
+    m_matrices.InverseView = glm::inverse(m_matrices.View);
+    m_matrices.InverseProjection = glm::inverse(m_matrices.Projection);
+    m_matrices.InverseViewProjection = m_matrices.InverseView * m_matrices.InverseProjection;
 
-    if (!ECS::Get().HasComponent<Transform>(id))
-        return Math::Mat4d(0.0);
-
-    // Called every frame inside your render/update loop if follow is enabled
-    if (CameraService().Get().enabled)
-    {
-        const EntityID& targetID = CameraService().Get().targetEntity;
-
-        if (ECS::Get().HasComponent<Transform>(targetID))
-        {
-            auto& targetTransform = *ECS::Get().GetComponent<Transform>(targetID);
-            const Position& pos = targetTransform.position / METERS_PER_UNIT;
-            Math::Vec3f targetPos = pos.GetWorld();
-
-            float distance = CameraService().Get().distance;
-            float yaw = CameraService().Get().yaw;
-            float pitch = CameraService().Get().pitch;
-
-            // Spherical to Cartesian
-            Math::Vec3f direction;
-            direction.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
-            direction.y = sin(glm::radians(pitch));
-            direction.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
-            direction = glm::normalize(direction);
-
-            Math::Vec3f cameraPos = targetPos - direction * distance;
-
-            // Now update camera's Transform
-            auto& cameraTransform = *ECS::Get().GetComponent<Transform>(id);
-            cameraTransform.position.SetWorld(cameraPos);
-
-            // Update camera direction
-            auto& camera = *ECS::Get().GetComponent<Camera>(id);
-            camera.SetFront(glm::normalize(targetPos - cameraPos));
-            camera.SetRight(glm::normalize(glm::cross(camera.GetFront(), camera.GetWorldUp())));
-            camera.SetUp(glm::cross(camera.GetRight(), camera.GetFront()));
-        }
-    }
-
-    Transform& transform = *ECS::Get().GetComponent<Transform>(id);
-    Position& pos = transform.position;
-
-    return glm::lookAt(Math::Vec3f(0.0), GetFront(), GetUp());
-}
-
-glm::mat4 Camera::GetProjectionMatrix() const
-{
-    return glm::perspective(glm::radians(GetZoom()), GetAspectRatio(), GetNearPlane(), GetFarPlane());
+    m_dirty = false;
+    return true;
 }
 
-void Camera::ProcessKeyboardMovement(Camera_Movement direction, float deltaTime)
+void Camera::ProcessKeyboardMovement(ECS& world, EntityID id, Camera_Movement direction, float deltaTime)
 {
-    auto& cameraIDs = ECS::Get().GetAllComponentIDs<Camera>();
-
-    if (cameraIDs.size() <= 0)
-        return;
-
-    const EntityID& id = cameraIDs[0];
-
-    if (!ECS::Get().HasComponent<Transform>(id) || !ECS::Get().HasComponent<Name>(id))
+    if (!world.HasComponents<Transform, Name>(id))
         return;
 
     float velocity = GetMovementSpeed() * deltaTime;
 
-    auto& transform = *ECS::Get().GetComponent<Transform>(id);
+    auto& transform = *world.GetComponent<Transform>(id);
 
     auto& pos = transform.position;
-    auto& name = ECS::Get().GetComponent<Name>(id)->name;
+    const auto& name = world.ReadComponent<Name>(id)->name;
 
     switch (direction) {
         case FORWARD:
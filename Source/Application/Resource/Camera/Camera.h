@@ -36,6 +36,17 @@ struct CameraDesc {
     float32 FarPlane = (AU / METERS_PER_UNIT) * 2;
 };
 
+// Derived once per frame by CameraUpdateSystem; rendering is camera-relative, so the view
+// only carries orientation
+struct CameraMatrices {
+    Math::Mat4f View = Math::Mat4f(1.0f);
+    Math::Mat4f Projection = Math::Mat4f(1.0f);
+    Math::Mat4f ViewProjection = Math::Mat4f(1.0f);
+    Math::Mat4f InverseView = Math::Mat4f(1.0f);
+    Math::Mat4f InverseProjection = Math::Mat4f(1.0f);
+    Math::Mat4f InverseViewProjection = Math::Mat4f(1.0f);
+};
+
 class Camera
 {
 public:
@@ -43,8 +54,14 @@ public:
     Camera();
     ~Camera() = default;
 
-    glm::mat4 GetViewMatrix() const;
-    glm::mat4 GetProjectionMatrix() const;
+    // Cached by UpdateMatrices; they lag until it runs after a change
+    const Math::Mat4f& GetViewMatrix() const { return m_matrices.View; }
+    const Math::Mat4f& GetProjectionMatrix() const { return m_matrices.Projection; }
+    const CameraMatrices& GetMatrices() const { return m_matrices; }
+
+    // Recomputes the matrices if anything they depend on changed; returns whether it did
+    bool8 UpdateMatrices();
+    bool8 IsDirty() const { return m_dirty; }
 
     const Math::Vec3f& GetFront() const { return m_cameraDesc.Front; }
     const Math::Vec3f& GetUp() const { return m_cameraDesc.Up; }
@@ -62,8 +79,8 @@ public:
     const float GetNearPlane() const { return m_cameraDesc.NearPlane; }
     const float GetFarPlane() const { return m_cameraDesc.FarPlane; }
 
-    void SetFront(const Math::Vec3f& Front) { m_cameraDesc.Front = Front; }
-    void SetUp(const Math::Vec3f& Up) { m_cameraDesc.Up = Up; }
+    void SetFront(const Math::Vec3f& Front) { m_cameraDesc.Front = Front; m_dirty = true; }
+    void SetUp(const Math::Vec3f& Up) { m_cameraDesc.Up = Up; m_dirty = true; }
     void SetRight(const Math::Vec3f& Right) { m_cameraDesc.Right = Right; }
     void SetWorldUp(const Math::Vec3f& WorldUp) { m_cameraDesc.WorldUp = WorldUp; }
 
@@ -73,15 +90,18 @@ public:
     void SetMovementSpeed(const float32& MovementSpeed) { m_cameraDesc.MovementSpeed = MovementSpeed; }
     void SetMovementSpeedMultiplier(const float32& MovementSpeedMultiplier) { m_cameraDesc.MovementSpeedMultiplier = MovementSpeedMultiplier; }
     void SetMouseSensitivity(const float32& MouseSensitivity) { m_cameraDesc.MouseSensitivity = MouseSensitivity; }
-    void SetZoom(const float32& Zoom) { m_cameraDesc.Zoom = Zoom; }
-    void SetAspectRatio(const float32& AspectRatio) { m_cameraDesc.AspectRatio = AspectRatio; }
-    void SetNearPlane(const float32& NearPlane) { m_cameraDesc.NearPlane = NearPlane; }
-    void SetFarPlane(const float32& FarPlane) { m_cameraDesc.FarPlane = FarPlane; }
+    void SetZoom(const float32& Zoom) { m_cameraDesc.Zoom = Zoom; m_dirty = true; }
+    void SetAspectRatio(const float32& AspectRatio) { m_cameraDesc.AspectRatio = AspectRatio; m_dirty = true; }
+    void SetNearPlane(const float32& NearPlane) { m_cameraDesc.NearPlane = NearPlane; m_dirty = true; }
+    void SetFarPlane(const float32& FarPlane) { m_cameraDesc.FarPlane = FarPlane; m_dirty = true; }
 
-    void ProcessKeyboardMovement(Camera_Movement direction, float deltaTime);
+    void ProcessKeyboardMovement(ECS& world, EntityID id, Camera_Movement direction, float deltaTime);
     void ProcessMouseMovement(float xoffset, float yoffset, bool constrainPitch = true);
     void UpdateCameraVectors();
 
 private:
     CameraDesc m_cameraDesc;
+
+    CameraMatrices m_matrices;
+    bool8 m_dirty = true;
 };
@@ -29,4 +29,16 @@ namespace Nyx
 		EntityID lockedEntity;
 	};
 
+	// Test particle: feels gravity from massive bodies but exerts none, so large
+	// populations cost O(N * massive) per step instead of O(N^2)
+	struct Massless {};
+
+	// Places an entity in its parent's frame; TransformSystem derives its world Transform.
+	// Position and rotation are inherited, scale is not (it is the body's own size).
+	struct Hierarchy
+	{
+		EntityID parent;
+		Transform local;
+	};
+
 }
\ No newline at end of file
@@ -12,7 +12,7 @@ class GridMesh {
 public:
     GridMesh();
 
-    void DrawGrid(const Camera& camera, const Transform& cameraTransform) const;
+    void DrawGrid(const Transform& cameraTransform) const;
 
 private:
     Vector<Math::Vec3f> m_vertices;
@@ -17,56 +17,48 @@ namespace Nyx
 			m_texture(texture) 
 		{}
 
-		void Bind()
+		void Bind() const
 		{
 			m_shader.Use();
 
 			bool hasTexture = m_texture && m_texture->GetID() != 0;
 
-			glActiveTexture(GL_TEXTURE0);
-
 			if (hasTexture)
 			{
-				glBindTexture(GL_TEXTURE_2D, m_texture->GetID());
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+				GLStateCache::Get().BindTexture(0, m_texture->GetID());
 			}
 			else
 			{
-				// Bind fallback white texture
+				// Bind fallback white texture, created once
 				static GLuint fallbackTexture = 0;
 
-				uint8_t whitePixel[3] = { 255, 255, 255 };
-
-				glGenTextures(1, &fallbackTexture);
-				glBindTexture(GL_TEXTURE_2D, fallbackTexture);
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, whitePixel);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			}
-
-			// Set texture uniform
-			GLuint texLoc = glGetUniformLocation(m_shader.GetID(), "uTexture");
-			glUniform1i(texLoc, 0);
-
-			// Send hasTexture flag
-			GLuint hasTexLoc = glGetUniformLocation(m_shader.GetID(), "uHasTexture");
-			glUniform1i(hasTexLoc, hasTexture);
+				if (fallbackTexture == 0)
+				{
+					uint8_t whitePixel[3] = { 255, 255, 255 };
 
-			// Send base color tint
-			GLuint colorLoc = glGetUniformLocation(m_shader.GetID(), "uBaseColor");
-			glUniform3fv(colorLoc, 1, glm::value_ptr(m_baseColor));
+					glGenTextures(1, &fallbackTexture);
+					GLStateCache::Get().BindTexture(0, fallbackTexture);
+					glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, whitePixel);
+					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+				}
 
-			// Send emissive color tint
-			GLuint emissiveLoc = glGetUniformLocation(m_shader.GetID(), "uEmissiveColor");
-			glUniform3fv(emissiveLoc, 1, glm::value_ptr(m_emissiveColor));
+				GLStateCache::Get().BindTexture(0, fallbackTexture);
+			}
 
-			// Send emissive color tint
-			GLuint emissiveStrengthLoc = glGetUniformLocation(m_shader.GetID(), "uEmissiveStrength");
-			glUniform1f(emissiveStrengthLoc, m_emissiveStrength);
+			m_shader.SetInt("uTexture", 0);
+			m_shader.SetBool("uHasTexture", hasTexture);
+			m_shader.SetVec3("uBaseColor", m_baseColor);
+			m_shader.SetVec3("uEmissiveColor", m_emissiveColor);
+			m_shader.SetFloat("uEmissiveStrength", m_emissiveStrength);
 		}
 
 		Shader& GetShader() { return m_shader; }
-		Math::Vec3f GetEmissiveColor() { return m_emissiveColor; }
+		const Shader& GetShader() const { return m_shader; }
+		Math::Vec3f GetEmissiveColor() const { return m_emissiveColor; }
+		const Math::Vec3f& GetBaseColor() const { return m_baseColor; }
+		float32 GetEmissiveStrength() const { return m_emissiveStrength; }
+		const Texture* GetTexture() const { return m_texture; }
 
 		void SetTexture(Texture* texture) { m_texture = texture; }
 		void SetBaseColor(const Math::Vec3f& color) { m_baseColor = color; }
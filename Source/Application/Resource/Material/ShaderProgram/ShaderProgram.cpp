@@ -0,0 +1,49 @@
+#include "ShaderProgram.h"
+
+namespace Nyx
+{
+	void Shader::Reflect()
+	{
+		m_uniforms = MakeShared<UniformTable>();
+
+		GLint count = 0;
+		GLint maxLength = 0;
+		glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+		String name(std::max(maxLength, 1), '\0');
+
+		for (GLint i = 0; i < count; ++i)
+		{
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(id, static_cast<GLuint>(i), maxLength, &length, &size, &type, name.data());
+
+			StringView uniformName(name.data(), length);
+
+			// Members of uniform blocks have no location; they are set through the block's buffer
+			GLint location = glGetUniformLocation(id, name.c_str());
+			if (location < 0)
+				continue;
+
+			m_uniforms->uniforms.emplace(HashUniformName(uniformName), Uniform(location));
+
+			// Arrays are reported as "name[0]"; also answer to the bare name, as GL does
+			if (uniformName.size() > 3 && uniformName.substr(uniformName.size() - 3) == "[0]")
+				m_uniforms->uniforms.emplace(HashUniformName(uniformName.substr(0, uniformName.size() - 3)), Uniform(location));
+		}
+
+		glGetProgramiv(id, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+		glGetProgramiv(id, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength);
+
+		name.assign(std::max(maxLength, 1), '\0');
+
+		for (GLint i = 0; i < count; ++i)
+		{
+			GLsizei length = 0;
+			glGetActiveUniformBlockName(id, static_cast<GLuint>(i), maxLength, &length, name.data());
+			m_uniforms->blocks.emplace(HashUniformName(StringView(name.data(), length)), static_cast<uint32>(i));
+		}
+	}
+}
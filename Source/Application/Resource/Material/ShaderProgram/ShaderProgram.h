@@ -1,13 +1,42 @@
 #pragma once
 
+#include <cstring>
+
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <glm/gtc/type_ptr.hpp>
 
 #include <Application/Core/Core.h>
+#include <Application/Constants/Constants.h>
 #include <Application/Utils/ShaderUtils/ShaderUtils.h>
+#include <Application/Core/Services/Pipeline/StateCache/GLStateCache.h>
 
 namespace Nyx
 {
+	// FNV-1a over a uniform or block name
+	constexpr uint64 HashUniformName(StringView name)
+	{
+		uint64 hash = 14695981039346656037ull;
+		for (char8 c : name)
+		{
+			hash ^= static_cast<uint8>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	// A hashed uniform name. Literals convert implicitly and are hashed at compile time;
+	// names built at runtime have to be wrapped explicitly, which makes the cost visible.
+	struct UniformName
+	{
+		template<usize N>
+		consteval UniformName(const char8 (&literal)[N]) : hash(HashUniformName(StringView(literal, N - 1))) {}
+
+		explicit constexpr UniformName(StringView name) : hash(HashUniformName(name)) {}
+
+		uint64 hash;
+	};
+
 	class Shader
 	{
 	public:
@@ -19,11 +48,12 @@ namespace Nyx
 		Shader(const String& vertexPath, const String& fragmentPath)
 		{
 			id = CreateShaderProgram(vertexPath, fragmentPath);
+			Reflect();
 		}
 
 		void Use() const
 		{
-			glUseProgram(id);
+			GLStateCache::Get().UseProgram(id);
 		}
 
 		uint32 GetID() const
@@ -31,7 +61,81 @@ namespace Nyx
 			return id;
 		}
 
+		// -1 when the program has no such active uniform, like glGetUniformLocation
+		int32 GetUniformLocation(UniformName name) const
+		{
+			const Uniform* uniform = Find(name.hash);
+			return uniform != nullptr ? uniform->location : -1;
+		}
+
+		// GL_INVALID_INDEX when the program has no such active block
+		uint32 GetUniformBlockIndex(UniformName name) const
+		{
+			if (m_uniforms == nullptr)
+				return GL_INVALID_INDEX;
+
+			auto it = m_uniforms->blocks.find(name.hash);
+			return it != m_uniforms->blocks.end() ? it->second : GL_INVALID_INDEX;
+		}
+
+		// Setters act on the program in use and skip the upload when the value is unchanged.
+		// Uniforms the program doesn't have are ignored.
+		void SetInt(UniformName name, int32 value) const { Set(name, value, [&](int32 location) { glUniform1i(location, value); }); }
+		void SetBool(UniformName name, bool8 value) const { SetInt(name, value ? 1 : 0); }
+		void SetFloat(UniformName name, float32 value) const { Set(name, value, [&](int32 location) { glUniform1f(location, value); }); }
+		void SetVec3(UniformName name, const Math::Vec3f& value) const { Set(name, value, [&](int32 location) { glUniform3fv(location, 1, glm::value_ptr(value)); }); }
+		void SetVec4(UniformName name, const Math::Vec4f& value) const { Set(name, value, [&](int32 location) { glUniform4fv(location, 1, glm::value_ptr(value)); }); }
+		void SetMat4(UniformName name, const Math::Mat4f& value) const { Set(name, value, [&](int32 location) { glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value)); }); }
+
 	private:
+		struct Uniform
+		{
+			explicit Uniform(int32 uniformLocation) : location(uniformLocation) {}
+
+			int32 location;
+
+			// The last uploaded value; a cache, so setters on a const Shader may update it
+			mutable bool8 valid = false; // whether value holds what the program has
+			alignas(16) mutable uint8 value[sizeof(Math::Mat4f)] = {};
+		};
+
+		// Shared by every copy of the Shader, since uniform values belong to the program
+		struct UniformTable
+		{
+			HashMap<uint64, Uniform> uniforms;
+			HashMap<uint64, uint32> blocks;
+		};
+
+		// Runs once after linking; defined in ShaderProgram.cpp
+		void Reflect();
+
+		const Uniform* Find(uint64 hash) const
+		{
+			if (m_uniforms == nullptr)
+				return nullptr;
+
+			auto it = m_uniforms->uniforms.find(hash);
+			return it != m_uniforms->uniforms.end() ? &it->second : nullptr;
+		}
+
+		template<typename T, typename Upload>
+		void Set(UniformName name, const T& value, Upload upload) const
+		{
+			static_assert(sizeof(T) <= sizeof(Uniform::value));
+
+			const Uniform* uniform = Find(name.hash);
+			if (uniform == nullptr)
+				return;
+
+			if (uniform->valid && std::memcmp(uniform->value, &value, sizeof(T)) == 0)
+				return;
+
+			std::memcpy(uniform->value, &value, sizeof(T));
+			uniform->valid = true;
+			upload(uniform->location);
+		}
+
 		uint32 id;
+		SharedPtr<UniformTable> m_uniforms;
 	};
-}
\ No newline at end of file
+}
@@ -2,6 +2,7 @@
 
 #include <Application/Core/Core.h>
 #include <Application/Utils/TextureUtils/TextureLoader.h>
+#include <Application/Core/Services/Pipeline/StateCache/GLStateCache.h>
 #include "Texture.h"
 
 namespace Nyx
@@ -15,6 +16,26 @@ namespace Nyx
 			throw std::runtime_error("Failed to load texture: " + path);
 		}
 
+		Upload(img);
+		TextureLoader::Free(img);
+	}
+
+	Texture::Texture(const TextureData& image)
+	{
+		if (!image.IsValid())
+		{
+			throw std::runtime_error("Failed to upload texture: no pixel data");
+		}
+
+		Upload(image);
+	}
+
+	void Texture::Upload(const TextureData& img)
+	{
+		m_width = img.width;
+		m_height = img.height;
+		m_channels = img.channels;
+
 		GLenum format = GL_RGB;
 		if (m_channels == 1)
 			format = GL_RED;
@@ -24,35 +45,29 @@ namespace Nyx
 			format = GL_RGBA;
 
 		glGenTextures(1, &m_textureID);
-		glBindTexture(GL_TEXTURE_2D, m_textureID);
-
-		m_width = img.width;
-		m_height = img.height;
-		m_channels = img.channels;
+		GLStateCache::Get().BindTexture(0, m_textureID);
 
 		glTexImage2D(GL_TEXTURE_2D, 0, format, m_width, m_height, 0, format, GL_UNSIGNED_BYTE, img.pixels);
 		glGenerateMipmap(GL_TEXTURE_2D);
 
-		// Set default parameters
-		glTextureParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTextureParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTextureParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		TextureLoader::Free(img);
+		// Set default parameters on the bound texture
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	}
 
 	Texture::~Texture()
 	{
 		if (m_textureID != 0)
 		{
+			GLStateCache::Get().ForgetTexture(m_textureID);
 			glDeleteTextures(1, &m_textureID);
 		}
 	}
 
 	void Texture::Bind(uint32 slot) const
 	{
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_2D, m_textureID);
+		GLStateCache::Get().BindTexture(slot, m_textureID);
 	}
 }
\ No newline at end of file
@@ -4,16 +4,23 @@
 
 namespace Nyx
 {
+	struct TextureData;
+
 	class Texture
 	{
 	public:
 		Texture(const String& path, bool flipVertically = true);
+
+		// Uploads pixels that were already decoded, e.g. on a worker thread
+		explicit Texture(const TextureData& image);
 		~Texture();
 
 		void Bind(uint32 slot = 0) const;
 		uint32 GetID() const { return m_textureID; }
 
 	private:
+		void Upload(const TextureData& image);
+
 		uint32 m_textureID = 0;
 		int32 m_width = 0;
 		int32 m_height = 0;
@@ -0,0 +1,13 @@
+// Shared by every shader that needs the camera; pulled in with #include after #version.
+// Filled once per frame by CameraUniforms; the std140 layout is mirrored in CameraBlock there.
+// Rendering is camera-relative, so these place the camera at the origin.
+layout (std140) uniform CameraBlock
+{
+    mat4 uView;
+    mat4 uProj;
+    mat4 uViewProj;
+    mat4 uInvView;
+    mat4 uInvProj;
+    mat4 uInvViewProj;
+    vec4 uCameraPlanes; // x near, y far
+};
@@ -1,11 +1,8 @@
 #version 330 core
+#include "../Common/camera.glsl"
 
 in vec3 nearPoint;
 in vec3 farPoint;
-in mat4 fragView;
-in mat4 fragProj;
-in float near;
-in float far;
 
 out vec4 FragColor;
 
@@ -29,13 +26,15 @@ vec4 grid(vec3 fragPos3D, float scale)
 
 float computeDepth(vec3 pos)
 {
-    vec4 clip = fragProj * fragView * vec4(pos, 1.0);
+    vec4 clip = uViewProj * vec4(pos, 1.0);
     return clip.z / clip.w;
 }
 
 float computeLinearDepth(vec3 pos)
 {
-    vec4 clip = fragProj * fragView * vec4(pos, 1.0);
+    vec4 clip = uViewProj * vec4(pos, 1.0);
+    float near = uCameraPlanes.x;
+    float far = uCameraPlanes.y;
     float ndcZ = (clip.z / clip.w) * 2.0 - 1.0;
     float lin = (2.0 * near * far) / (far + near - ndcZ * (far - near));
     return lin / far;
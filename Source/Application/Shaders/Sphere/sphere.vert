@@ -1,12 +1,11 @@
 #version 330 core
+#include "../Common/camera.glsl"
 
 layout (location = 0) in vec3 aPos; // Position
 layout (location = 1) in vec2 aUV;  // Texture coordinate
 layout (location = 2) in vec3 aNormal; // Normal
 
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProj;
 
 out vec2 vUV;
 out vec3 vNormal;
@@ -22,5 +21,5 @@ void main()
     // Transform normal to world space
     vNormal = mat3(transpose(inverse(uModel))) * aNormal;
 
-    gl_Position = uProj * uView * worldPos;
+    gl_Position = uViewProj * worldPos;
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#version 330 core
+#include "../Common/camera.glsl"
+#include "sphere_lighting.glsl"
+
+in vec3 vRayPoint;
+flat in vec3 vCenter;
+flat in float vRadius;
+flat in mat3 vToLocal;
+flat in vec3 vBaseColor;
+flat in vec3 vEmissiveColor;
+flat in float vEmissiveStrength;
+
+out vec4 FragColor;
+
+uniform sampler2D uTexture;
+uniform bool uHasTexture;
+
+#define PI 3.14159265358979
+
+void main()
+{
+    vec3 ray = normalize(vRayPoint);
+
+    // Ray from the camera at the origin against the sphere, using the perpendicular offset
+    // rather than |center|^2 - r^2 so far away bodies keep their precision
+    float along = dot(ray, vCenter);
+    vec3 offset = vCenter - along * ray;
+    float h = vRadius * vRadius - dot(offset, offset);
+    if (h < 0.0)
+        discard;
+
+    h = sqrt(h);
+    float t = along - h;
+    if (t < 0.0)
+        t = along + h; // inside the sphere, so the far side is the visible one
+
+    vec3 fragPos = t * ray;
+    vec3 normal = (fragPos - vCenter) / vRadius;
+
+    vec4 clipPos = uViewProj * vec4(fragPos, 1.0);
+    gl_FragDepth = 0.5 * (clipPos.z / clipPos.w) + 0.5;
+
+    vec3 baseColor = vBaseColor;
+
+    if (uHasTexture)
+    {
+        // Inverse of the mapping in MeshBuilder::GenerateVertices
+        vec3 local = vToLocal * (fragPos - vCenter);
+        float theta = atan(local.z, local.x); // [-PI, PI]
+        float v = acos(clamp(local.y, -1.0, 1.0)) / PI;
+        float u = 1.0 - fract(theta / (2.0 * PI));
+
+        // At the seam u jumps from 1 to 0; take whichever of the two wrappings is continuous
+        // here so the derivatives stay small and mip selection doesn't draw a line
+        float wrapped = fract(u + 0.5) - 0.5;
+        u = fwidth(u) <= fwidth(wrapped) ? u : wrapped;
+
+        baseColor *= texture(uTexture, vec2(u, v)).rgb;
+    }
+
+    vec3 finalColor = ShadeSphere(fragPos, normal, baseColor, vEmissiveColor, vEmissiveStrength);
+
+    FragColor = vec4(finalColor, 1.0);
+}
@@ -0,0 +1,50 @@
+#version 330 core
+#include "../Common/camera.glsl"
+
+layout (location = 0) in vec2 aCorner; // quad corner in [-1, 1]
+
+// Per instance
+layout (location = 3) in mat4 iModel; // occupies locations 3 to 6
+layout (location = 7) in vec4 iBaseColor; // rgb color, a emissive strength
+layout (location = 8) in vec3 iEmissiveColor;
+
+out vec3 vRayPoint; // a point on the view ray through this fragment; the camera is the origin
+flat out vec3 vCenter;
+flat out float vRadius;
+flat out mat3 vToLocal; // world directions to the unit sphere's frame, for the UV
+flat out vec3 vBaseColor;
+flat out vec3 vEmissiveColor;
+flat out float vEmissiveStrength;
+
+void main()
+{
+    vCenter = iModel[3].xyz;
+    vRadius = length(iModel[0].xyz);
+    vToLocal = transpose(mat3(iModel)) / (vRadius * vRadius);
+
+    vBaseColor = iBaseColor.rgb;
+    vEmissiveStrength = iBaseColor.a;
+    vEmissiveColor = iEmissiveColor;
+
+    float distance = length(vCenter);
+
+    if (distance <= vRadius * 1.001)
+    {
+        // Camera inside the sphere: cover the screen and trace the far side
+        gl_Position = vec4(aCorner, 0.0, 1.0);
+        vec4 viewPoint = uInvProj * gl_Position;
+        vRayPoint = mat3(uInvView) * (viewPoint.xyz / viewPoint.w);
+        return;
+    }
+
+    // Square facing the camera through the center, just wide enough to hold the silhouette cone
+    vec3 forward = vCenter / distance;
+    vec3 cameraUp = vec3(uView[0][1], uView[1][1], uView[2][1]);
+    vec3 right = normalize(cross(forward, cameraUp));
+    vec3 up = cross(right, forward);
+
+    float extent = vRadius * distance / sqrt(distance * distance - vRadius * vRadius);
+
+    vRayPoint = vCenter + (aCorner.x * right + aCorner.y * up) * extent;
+    gl_Position = uViewProj * vec4(vRayPoint, 1.0);
+}
@@ -0,0 +1,26 @@
+#version 330 core
+#include "sphere_lighting.glsl"
+
+in vec2 vUV;
+in vec3 vNormal;
+in vec3 vFragPos;
+flat in vec3 vBaseColor;
+flat in vec3 vEmissiveColor;
+flat in float vEmissiveStrength;
+
+out vec4 FragColor;
+
+uniform sampler2D uTexture;
+uniform bool uHasTexture;
+
+void main()
+{
+    vec3 baseColor = vBaseColor;
+
+    if (uHasTexture) 
+        baseColor *= texture(uTexture, vUV).rgb;
+
+    vec3 finalColor = ShadeSphere(vFragPos, normalize(vNormal), baseColor, vEmissiveColor, vEmissiveStrength);
+
+    FragColor = vec4(finalColor, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#version 330 core
+#include "../Common/camera.glsl"
+
+layout (location = 0) in vec3 aPos; // Position
+layout (location = 1) in vec2 aUV;  // Texture coordinate
+layout (location = 2) in vec3 aNormal; // Normal
+
+// Per instance
+layout (location = 3) in mat4 iModel; // occupies locations 3 to 6
+layout (location = 7) in vec4 iBaseColor; // rgb color, a emissive strength
+layout (location = 8) in vec3 iEmissiveColor;
+
+out vec2 vUV;
+out vec3 vNormal;
+out vec3 vFragPos;
+flat out vec3 vBaseColor;
+flat out vec3 vEmissiveColor;
+flat out float vEmissiveStrength;
+
+void main()
+{
+    vUV = aUV;
+
+    vec4 worldPos = iModel * vec4(aPos, 1.0);
+    vFragPos = worldPos.xyz;
+
+    // Spheres are scaled uniformly, so the model matrix itself keeps normals perpendicular
+    vNormal = mat3(iModel) * aNormal;
+
+    vBaseColor = iBaseColor.rgb;
+    vEmissiveStrength = iBaseColor.a;
+    vEmissiveColor = iEmissiveColor;
+
+    gl_Position = uViewProj * worldPos;
+}
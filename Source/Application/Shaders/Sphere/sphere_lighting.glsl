@@ -0,0 +1,84 @@
+// Shared lighting for every sphere shader; pulled in with #include after #version
+#define MAX_DIR_LIGHTS 4
+#define MAX_POINT_LIGHTS 16
+
+struct DirectionalLight
+{
+    vec3 direction;
+    vec3 color;
+    float intensity;
+};
+
+struct PointLight
+{
+    vec3 position;
+    vec3 color;
+    float intensity;
+    float range;    // Max distance
+    float decay;    // Quadratic fallout control
+};
+
+// Filled once per frame by LightingSystem; the std140 layout is mirrored there
+layout (std140) uniform DirectionalLightBlock
+{
+    int uDirLightCount;
+    DirectionalLight uDirectionalLights[MAX_DIR_LIGHTS];
+};
+
+layout (std140) uniform PointLightBlock
+{
+    int uPointLightCount;
+    PointLight uPointLights[MAX_POINT_LIGHTS];
+};
+
+vec3 ComputeDirectionalLight(vec3 normal) {
+    vec3 result = vec3(0.0);
+    vec3 N = normalize(normal);
+
+    for (int i = 0; i < uDirLightCount; ++i) {
+        vec3 L = normalize(-uDirectionalLights[i].direction);
+
+        float diff = max(dot(N, L), 0.0);
+        vec3 diffuse = uDirectionalLights[i].color * uDirectionalLights[i].intensity * diff;
+
+        vec3 ambient = 0.0 * uDirectionalLights[i].color;
+
+        result += ambient + diffuse;
+    }
+
+    return result;
+}
+
+vec3 ComputePointLights(vec3 fragPos, vec3 normal)
+{
+    vec3 result = vec3(0.0);
+    vec3 N = normalize(normal);
+
+    for (int i = 0; i < uPointLightCount; ++i)
+    {
+        PointLight light = uPointLights[i];
+        vec3 L = light.position - fragPos;
+        float distance = length(L);
+        L = normalize(L);
+
+        float attenuation = 1.0 / (1.0 + light.decay * distance * distance);
+        attenuation *= clamp(1.0 - (distance / light.range), 0.0, 1.0);
+
+        float diff = max(dot(N, L), 0.0);
+        vec3 diffuse = light.color * light.intensity * diff * attenuation;
+
+        result += diffuse;
+    }
+
+    return result;
+}
+
+// Surface color at a point with a world-space normal: emissive blend plus the lit base color
+vec3 ShadeSphere(vec3 fragPos, vec3 normal, vec3 baseColor, vec3 emissiveColor, float emissiveStrength)
+{
+    vec3 lighting = ComputeDirectionalLight(normal); // directional lights
+    lighting += ComputePointLights(fragPos, normal); // point lights
+
+    vec3 glowBlend = mix(baseColor, emissiveColor, emissiveStrength);
+    return glowBlend + baseColor * lighting;
+}
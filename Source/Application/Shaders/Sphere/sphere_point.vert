@@ -0,0 +1,17 @@
+#version 330 core
+#include "../Common/camera.glsl"
+
+// Per instance; only the center and colors are used
+layout (location = 3) in mat4 iModel; // occupies locations 3 to 6
+layout (location = 7) in vec4 iBaseColor; // rgb color, a emissive strength
+layout (location = 8) in vec3 iEmissiveColor;
+
+flat out vec3 vColor;
+
+void main()
+{
+    // Too small to light meaningfully, so take the unlit blend the lit shaders start from
+    vColor = mix(iBaseColor.rgb, iEmissiveColor, iBaseColor.a);
+
+    gl_Position = uViewProj * vec4(iModel[3].xyz, 1.0);
+}
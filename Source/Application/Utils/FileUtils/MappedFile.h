@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+
+namespace Nyx
+{
+	// Read-only view of a whole file mapped into memory
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool8 Open(const String& path);
+		void Close();
+
+		bool8 IsOpen() const { return m_data != nullptr; }
+		const uint8* GetData() const { return m_data; }
+		usize GetSize() const { return m_size; }
+
+	private:
+		const uint8* m_data = nullptr;
+		usize m_size = 0;
+
+#ifdef SPACESIM_WINDOWS
+		void* m_fileHandle = nullptr;
+		void* m_mappingHandle = nullptr;
+#endif
+	};
+}
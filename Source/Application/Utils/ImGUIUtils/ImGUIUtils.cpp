@@ -5,6 +5,9 @@
 #include <Application/Utils/ImGUIUtils/ImGUIUtils.h>
 #include <Application/Core/Services/Editor/Editor.h>
 #include <Application/Core/Services/CameraService/CameraService.h>
+#include <Application/Core/Services/Snapshot/Snapshot.h>
+#include <Application/Core/Services/Rewind/RewindBuffer.h>
+#include <Application/Utils/StatsUtils/StatsUtils.h>
 
 void ImGUIUtils::Initialize(void* window)
 {
@@ -64,22 +67,157 @@ ImVec2 ImGUIUtils::DrawGameWindow(Engine* engine)
     return textureSize;
 }
 
-void ImGUIUtils::DrawSimulationControl(Engine* engine)
+void ImGUIUtils::DrawSimulationControl(Engine* engine, Scene* scenePtr)
 {
+    static char snapshotPath[256] = "Nyx.snapshot";
+
     ImGui::Begin("Simulation Control");
     ImGui::SliderFloat("Time Scale", &TIME_SCALE, 0.0f, 50000.0f, "%.8f", ImGuiSliderFlags_Logarithmic);
     ImGui::Checkbox("Show Grid", &engine->GetRenderer().m_gridEnabled);
+    ImGui::Checkbox("Instanced Spheres", &engine->GetRenderer().m_instancingEnabled);
+    ImGui::Text("%u spheres in %u draw calls, %zu shared meshes", engine->GetRenderer().GetSphereCount(),
+        engine->GetRenderer().GetSphereDrawCalls(), ResourceManager::GetLiveMeshCount());
+
+    ImGui::Text("GL state calls: %llu sent, %llu skipped", (unsigned long long)GLStateCache::Get().GetIssuedCount(),
+        (unsigned long long)GLStateCache::Get().GetSkippedCount());
+
+    ImGui::Checkbox("Frustum Culling", &engine->GetRenderer().m_cullingEnabled);
+    if (engine->GetRenderer().m_cullingEnabled)
+    {
+        SphereCuller& culler = engine->GetRenderer().GetSphereCuller();
+        ImGui::SliderFloat("Min Pixel Radius", &culler.m_minPixelRadius, 0.0f, 8.0f, "%.2f");
+        ImGui::Text("%u as geometry, %zu as points, %u culled", engine->GetRenderer().GetMeshSphereCount(),
+            culler.GetPoints().size(), culler.GetCulledCount());
+    }
+
+    ImGui::Checkbox("Ray-cast Impostors", &engine->GetRenderer().m_impostorsEnabled);
+    ImGui::Checkbox("Sphere LOD", &engine->GetRenderer().m_lodEnabled);
+    ImGui::Text("%llu sphere vertices", (unsigned long long)engine->GetRenderer().GetSphereVertexCount());
+    if (engine->GetRenderer().m_lodEnabled && !engine->GetRenderer().m_impostorsEnabled)
+    {
+        SphereLOD& lod = engine->GetRenderer().GetSphereLOD();
+        ImGui::SliderFloat("Pixels per Segment", &lod.m_pixelsPerSegment, 1.0f, 32.0f, "%.1f");
+        for (uint32 level = 0; level < SphereLOD::LEVEL_COUNT; ++level)
+        {
+            ImGui::Text("  res %3u: %u", SphereLOD::RESOLUTIONS[level], lod.GetLevelCount(level));
+        }
+    }
+
+    ImGui::Separator();
+    ImGui::InputText("Snapshot", snapshotPath, sizeof(snapshotPath));
+    if (ImGui::Button("Save Snapshot"))
+        Snapshot::Save(scenePtr->GetWorld(), snapshotPath);
+    ImGui::SameLine();
+    if (ImGui::Button("Load Snapshot"))
+        Snapshot::Load(scenePtr->GetWorld(), snapshotPath);
+
+    ImGui::Separator();
+    RewindBuffer& rewind = RewindBuffer::Get();
+    double oldest = rewind.GetOldestTime();
+    double newest = rewind.GetNewestTime();
+    double scrubTime = rewind.GetTime();
+
+    if (ImGui::SliderScalar("Rewind (s)", ImGuiDataType_Double, &scrubTime, &oldest, &newest, "%.1f"))
+        rewind.Restore(scenePtr->GetWorld(), scrubTime);
+
+    ImGui::Text("%zu samples, %s", rewind.GetSampleCount(), FormatBytes(rewind.GetMemoryUsage()).c_str());
+
+    ImGui::End();
+}
+
+void ImGUIUtils::DrawSystemProfiler(Engine* engine)
+{
+    const SystemScheduler& scheduler = engine->GetScheduler();
+
+    ImGui::Begin("System Profiler");
+    ImGui::Text("Frame: %.3f ms (%u workers)", scheduler.GetFrameTimeMs(), scheduler.GetWorkerCount());
+
+    if (ImGui::BeginTable("Systems", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("System");
+        ImGui::TableSetupColumn("Level");
+        ImGui::TableSetupColumn("Last (ms)");
+        ImGui::TableSetupColumn("Avg (ms)");
+        ImGui::TableHeadersRow();
+
+        for (const SystemTiming& timing : scheduler.GetTimings())
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%s%s", timing.name.data(), timing.mainThread ? " (main)" : "");
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", timing.level);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", timing.lastMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", timing.averageMs);
+        }
+
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+void ImGUIUtils::DrawECSStats(ECS& world)
+{
+    // Walking every pool each frame would skew the profiler; refresh twice a second
+    static WorldStats stats;
+    static float64 lastRefresh = -1.0;
+
+    if (lastRefresh < 0.0 || ImGui::GetTime() - lastRefresh > 0.5)
+    {
+        stats = world.GetStats();
+        lastRefresh = ImGui::GetTime();
+    }
+
+    ImGui::Begin("ECS Memory");
+    ImGui::Text("Entities: %zu alive, next ID %u", stats.entities.alive, stats.entities.nextID);
+    ImGui::Text("Free list: %zu IDs in %zu runs", stats.entities.freeListSize, stats.entities.freeListRuns);
+    ImGui::Text("Total: %s", FormatBytes(stats.totalBytes).data());
+
+    if (ImGui::Button("Log Stats"))
+        spdlog::info("\n{}", FormatWorldStats(world.GetStats()));
+
+    if (ImGui::BeginTable("Pools", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("Pool");
+        ImGui::TableSetupColumn("Count");
+        ImGui::TableSetupColumn("Capacity");
+        ImGui::TableSetupColumn("Reserved");
+        ImGui::TableSetupColumn("Sparse");
+        ImGui::TableSetupColumn("Sparse Mem");
+        ImGui::TableHeadersRow();
+
+        for (const PoolStats& pool : stats.pools)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", pool.name.data());
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", pool.count);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", pool.capacity);
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", FormatBytes(pool.bytesReserved).data());
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", pool.sparseSize);
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", FormatBytes(pool.sparseBytes).data());
+        }
+
+        ImGui::EndTable();
+    }
     ImGui::End();
 }
 
-void ImGUIUtils::DrawHierarchy()
+void ImGUIUtils::DrawHierarchy(ECS& world)
 {
     Optional<EntityID>& selectedEntity = Editor::Get().selectedEntity;
 
     ImGui::Begin("Hierarchy");
-    for (EntityID entityID : ECS::Get().View<Name>())
+    for (EntityID entityID : world.View<Name>())
     {
-        Name& name = *ECS::Get().GetComponent<Name>(entityID);
+        const Name& name = *world.ReadComponent<Name>(entityID);
         bool selected = (selectedEntity.has_value() && selectedEntity.value() == entityID);
         if (ImGui::Selectable(name.name.data(), selected))
             selectedEntity = entityID;
@@ -87,27 +225,28 @@ void ImGUIUtils::DrawHierarchy()
     ImGui::End();
 }
 
-void ImGUIUtils::DrawInspector()
+void ImGUIUtils::DrawInspector(ECS& world)
 {
     Optional<EntityID>& selectedEntity = Editor::Get().selectedEntity;
 
     ImGui::Begin("Inspector");
-    if (selectedEntity.has_value())
+    // The selection may belong to a world that is no longer shown
+    if (selectedEntity.has_value() && world.HasComponent<Name>(selectedEntity.value()))
     {
         EntityID& id = selectedEntity.value();
-        String& name = ECS::Get().GetComponent<Name>(id)->name;
+        const String& name = world.ReadComponent<Name>(id)->name;
 
         ImGui::Text("[%s]", name.data());
 
-        if (ECS::Get().HasComponent<Transform>(id))
+        if (world.HasComponent<Transform>(id))
         {
-            auto& transform = *ECS::Get().GetComponent<Transform>(id);
+            const auto& transform = *world.ReadComponent<Transform>(id);
 
             const auto& pos = transform.position.GetWorld();
             const auto& rot = transform.rotation.GetEulerAngles();
             const auto& sca = transform.scale.get();
 
-            bool hasCamera = ECS::Get().HasComponent<Camera>(id);
+            bool hasCamera = world.HasComponent<Camera>(id);
 
             if (hasCamera == false)
             {
@@ -128,7 +267,7 @@ void ImGUIUtils::DrawInspector()
             ImGui::Text("Pos: (%.2f, %.2f, %.2f)", pos.x, pos.y, pos.z);
             if (hasCamera)
             {
-                const auto& camera = *ECS::Get().GetComponent<Camera>(id);
+                const auto& camera = *world.ReadComponent<Camera>(id);
                 ImGui::Text("Yaw: %.2f", camera.GetYaw());
                 ImGui::Text("Pitch: %.2f", camera.GetPitch());
             }
@@ -139,10 +278,21 @@ void ImGUIUtils::DrawInspector()
             }
         }
 
-        if (ECS::Get().HasComponent<Rigidbody>(id))
+        if (world.HasComponent<Hierarchy>(id))
         {
             ImGui::Separator();
-            const auto& rigidbody = *ECS::Get().GetComponent<Rigidbody>(id);
+            const auto& hierarchy = *world.ReadComponent<Hierarchy>(id);
+            const auto& localPos = hierarchy.local.position.GetWorld();
+
+            if (world.HasComponent<Name>(hierarchy.parent))
+                ImGui::Text("Parent: %s", world.ReadComponent<Name>(hierarchy.parent)->name.data());
+            ImGui::Text("Local Pos: (%.2f, %.2f, %.2f)", localPos.x, localPos.y, localPos.z);
+        }
+
+        if (world.HasComponent<Rigidbody>(id))
+        {
+            ImGui::Separator();
+            const auto& rigidbody = *world.ReadComponent<Rigidbody>(id);
 
             const auto& velVec = rigidbody.velocity.GetWorld();
             const auto& accVec = rigidbody.acceleration.GetWorld();
@@ -164,9 +314,11 @@ void ImGUIUtils::DrawWindow(Engine* enginePtr, Scene* scenePtr)
 
     ImGUIUtils::InitDockableWindow();
     ImVec2 textureSize = ImGUIUtils::DrawGameWindow(enginePtr);
-    ImGUIUtils::DrawSimulationControl(enginePtr);
-    ImGUIUtils::DrawHierarchy();
-    ImGUIUtils::DrawInspector();
+    ImGUIUtils::DrawSimulationControl(enginePtr, scenePtr);
+    ImGUIUtils::DrawSystemProfiler(enginePtr);
+    ImGUIUtils::DrawECSStats(scenePtr->GetWorld());
+    ImGUIUtils::DrawHierarchy(scenePtr->GetWorld());
+    ImGUIUtils::DrawInspector(scenePtr->GetWorld());
 
     Math::Vec2f textureSizeVec = { (int)textureSize.x, (int)textureSize.y };
     enginePtr->ResizeFBO(textureSizeVec, scenePtr);
@@ -181,4 +333,7 @@ void ImGUIUtils::DrawWindow(Engine* enginePtr, Scene* scenePtr)
         ImGui::RenderPlatformWindowsDefault();
         glfwMakeContextCurrent(backup);
     }
+
+    // The backend sets GL state behind the cache's back
+    GLStateCache::Get().Invalidate();
 }
\ No newline at end of file
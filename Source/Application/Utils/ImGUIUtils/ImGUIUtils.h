@@ -20,11 +20,15 @@ namespace ImGUIUtils
 
 	ImVec2 DrawGameWindow(Engine* engine);
 
-	void DrawSimulationControl(Engine* engine);
+	void DrawSimulationControl(Engine* engine, Scene* scenePtr);
 
-	void DrawHierarchy();
+	void DrawSystemProfiler(Engine* engine);
 
-	void DrawInspector();
+	void DrawECSStats(ECS& world);
+
+	void DrawHierarchy(ECS& world);
+
+	void DrawInspector(ECS& world);
 
 	void DrawWindow(Engine* enginePtr, Scene* scenePtr);
 }
@@ -0,0 +1,68 @@
+#pragma once
+#include <cmath>
+#include <numbers>
+
+#include <Application/Core/Core.h>
+
+namespace Nyx
+{
+	// xoshiro256** seeded through SplitMix64. Unlike the <random> distributions the output
+	// is specified bit for bit, so a seed gives the same population on every platform.
+	class Random
+	{
+	public:
+		explicit Random(uint64 seed)
+		{
+			for (uint64& word : m_state)
+				word = SplitMix64(seed);
+		}
+
+		// Independent generator for one stream (e.g. one chunk of work) of a seeded run
+		static Random ForStream(uint64 seed, uint64 stream)
+		{
+			uint64 state = seed;
+			return Random(SplitMix64(state) ^ (stream * 0xD1B54A32D192ED03ull));
+		}
+
+		uint64 Next()
+		{
+			const uint64 result = Rotl(m_state[1] * 5, 7) * 9;
+			const uint64 t = m_state[1] << 17;
+
+			m_state[2] ^= m_state[0];
+			m_state[3] ^= m_state[1];
+			m_state[1] ^= m_state[2];
+			m_state[0] ^= m_state[3];
+			m_state[2] ^= t;
+			m_state[3] = Rotl(m_state[3], 45);
+
+			return result;
+		}
+
+		// [0, 1) with 53 random bits
+		float64 NextDouble() { return (Next() >> 11) * 0x1.0p-53; }
+
+		float64 Uniform(float64 low, float64 high) { return low + (high - low) * NextDouble(); }
+
+		float64 Normal(float64 mean, float64 sigma)
+		{
+			// Box-Muller; the second value is dropped to keep streams simple
+			float64 u1 = 1.0 - NextDouble();
+			float64 u2 = NextDouble();
+			return mean + sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * std::numbers::pi * u2);
+		}
+
+	private:
+		static uint64 SplitMix64(uint64& state)
+		{
+			uint64 z = (state += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+
+		static uint64 Rotl(uint64 x, int32 k) { return (x << k) | (x >> (64 - k)); }
+
+		uint64 m_state[4];
+	};
+}
@@ -0,0 +1,164 @@
+#include "MeshBuilder.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <Application/Core/Services/Pipeline/StateCache/GLStateCache.h>
+
+namespace Nyx
+{
+	namespace
+	{
+		Vector<float32> GenerateVertices(const uint32 resolution)
+		{
+			Vector<float32> vertices;
+
+			for (uint32 y = 0; y <= resolution; ++y)
+			{
+				float v = (float)y / resolution; // V coordinate
+
+				for (uint32 x = 0; x <= resolution; ++x)
+				{
+					float u = 1.0f - ((float)x / resolution); // flipped U
+
+					float theta = (1.0f - u) * glm::two_pi<float>(); // longitude [0, 2PI]
+					float phi = v * glm::pi<float>();       // latitude  [0, PI]
+
+					Math::Vec3f pos;
+					pos.x = sinf(phi) * cosf(theta);
+					pos.y = cosf(phi);
+					pos.z = sinf(phi) * sinf(theta);
+
+					Math::Vec3f norm = glm::normalize(pos);
+
+					vertices.push_back(pos.x);
+					vertices.push_back(pos.y);
+					vertices.push_back(pos.z);
+
+					vertices.push_back(u); // flipped U
+					vertices.push_back(v); // V
+
+					vertices.push_back(norm.x);
+					vertices.push_back(norm.y);
+					vertices.push_back(norm.z);
+				}
+			}
+
+			return vertices;
+		}
+
+		Vector<uint32> GenerateIndices(const uint32 resolution)
+		{
+			Vector<uint32> indices;
+
+			for (uint32 y = 0; y < resolution; ++y)
+			{
+				for (uint32 x = 0; x < resolution; ++x)
+				{
+					uint32 i0 = y * (resolution + 1) + x;
+					uint32 i1 = i0 + 1;
+					uint32 i2 = i0 + (resolution + 1);
+					uint32 i3 = i2 + 1;
+
+					// Two triangles per quad
+					indices.push_back(i0);
+					indices.push_back(i2);
+					indices.push_back(i1);
+
+					indices.push_back(i1);
+					indices.push_back(i2);
+					indices.push_back(i3);
+				}
+			}
+
+			return indices;
+		}
+	}
+
+	Mesh MeshBuilder::CreateSphere(uint32 resolution)
+	{
+		Vector<float32> vertices = GenerateVertices(resolution);
+		Vector<uint32> indices = GenerateIndices(resolution);
+
+		Mesh mesh;
+
+		glGenVertexArrays(1, &mesh.vao.m_data);
+		glGenBuffers(1, &mesh.vbo.m_data);
+		glGenBuffers(1, &mesh.ebo.m_data);
+
+		GLStateCache::Get().BindVertexArray(mesh.vao.m_data);
+
+		glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo.m_data);
+		glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo.m_data);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+		SetSphereVertexLayout();
+
+		GLStateCache::Get().BindVertexArray(0);
+
+		mesh.ebo.m_indexCount = static_cast<uint32>(indices.size());
+
+		return mesh;
+	}
+
+	void MeshBuilder::SetSphereVertexLayout()
+	{
+		// Position attribute (location = 0)
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+		glEnableVertexAttribArray(0);
+
+		// UV attribute (location = 1)
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
+		glEnableVertexAttribArray(1);
+
+		// Normal attribute (location = 2)
+		glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(5 * sizeof(float)));
+		glEnableVertexAttribArray(2);
+	}
+
+	Mesh MeshBuilder::CreateQuad()
+	{
+		const float32 corners[] = { -1.0f, -1.0f,  1.0f, -1.0f,  1.0f, 1.0f,  -1.0f, 1.0f };
+		const uint32 indices[] = { 0, 1, 2,  0, 2, 3 };
+
+		Mesh mesh;
+
+		glGenVertexArrays(1, &mesh.vao.m_data);
+		glGenBuffers(1, &mesh.vbo.m_data);
+		glGenBuffers(1, &mesh.ebo.m_data);
+
+		GLStateCache::Get().BindVertexArray(mesh.vao.m_data);
+
+		glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo.m_data);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo.m_data);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+		SetQuadVertexLayout();
+
+		GLStateCache::Get().BindVertexArray(0);
+
+		mesh.ebo.m_indexCount = 6;
+
+		return mesh;
+	}
+
+	void MeshBuilder::SetQuadVertexLayout()
+	{
+		// Corner attribute (location = 0)
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+		glEnableVertexAttribArray(0);
+	}
+
+	void MeshBuilder::Destroy(const Mesh& mesh)
+	{
+		GLStateCache::Get().ForgetVertexArray(mesh.vao.m_data);
+		glDeleteVertexArrays(1, &mesh.vao.m_data);
+		glDeleteBuffers(1, &mesh.vbo.m_data);
+		glDeleteBuffers(1, &mesh.ebo.m_data);
+	}
+}
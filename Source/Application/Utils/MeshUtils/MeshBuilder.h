@@ -0,0 +1,23 @@
+#pragma once
+
+#include <Application/Core/Core.h>
+#include <Application/Resource/Buffers/Mesh.h>
+
+namespace Nyx
+{
+	class MeshBuilder
+	{
+	public:
+		// Unit sphere with (resolution + 1)^2 vertices: position, UV and normal interleaved
+		static Mesh CreateSphere(uint32 resolution);
+
+		// Attribute pointers 0 to 2 for the currently bound sphere vertex buffer
+		static void SetSphereVertexLayout();
+
+		// Two triangles over [-1, 1]^2 with only a 2D corner position at attribute 0
+		static Mesh CreateQuad();
+		static void SetQuadVertexLayout();
+
+		static void Destroy(const Mesh& mesh);
+	};
+}
@@ -2,7 +2,12 @@
 
 #include <spdlog/spdlog.h>
 
-static String ReadFile(const String& filePath)
+#include <Application/Constants/Constants.h>
+
+// Expands `#include "file"` lines, resolved against the including file's directory. Each file
+// is pulled in at most once per shader, and #line directives keep compiler messages pointing
+// at the right line of the including file.
+static String ReadFile(const String& filePath, Set<String>& included)
 {
 	IfStream file(filePath);
 	if (!file.is_open())
@@ -11,9 +16,49 @@ static String ReadFile(const String& filePath)
 		return "";
 	}
 
-	StringStream ss;
-	ss << file.rdbuf();
-	return ss.str();
+	String source;
+	String line;
+	uint32 lineNumber = 0;
+
+	while (std::getline(file, line))
+	{
+		++lineNumber;
+
+		usize directive = line.find_first_not_of(" \t");
+		if (directive == String::npos || line.compare(directive, 8, "#include") != 0)
+		{
+			source += line;
+			source += '\n';
+			continue;
+		}
+
+		usize open = line.find('"', directive);
+		usize close = open != String::npos ? line.find('"', open + 1) : String::npos;
+		if (close == String::npos)
+		{
+			spdlog::critical("Malformed #include in {}:{}", filePath, lineNumber);
+			continue;
+		}
+
+		FileSystem::path includePath = FileSystem::path(filePath).parent_path() / line.substr(open + 1, close - open - 1);
+		String includeName = includePath.lexically_normal().string();
+
+		if (included.insert(includeName).second)
+		{
+			source += "#line 1\n";
+			source += ReadFile(includeName, included);
+		}
+
+		source += "#line " + std::to_string(lineNumber + 1) + "\n";
+	}
+
+	return source;
+}
+
+static String ReadFile(const String& filePath)
+{
+	Set<String> included;
+	return ReadFile(filePath, included);
 }
 
 static uint32 CompileShader(GLenum type, const String& source)
@@ -62,5 +107,19 @@ uint32 CreateShaderProgram(const String& vertexPath, const String& fragmentPath)
 	glDeleteShader(vertexShader);
 	glDeleteShader(fragmentShader);
 
+	// GLSL 330 can't give blocks a binding in the source, so shared blocks are wired up here
+	const Pair<const char*, uint32> sharedBlocks[] = {
+		{ "DirectionalLightBlock", DIRECTIONAL_LIGHT_BINDING },
+		{ "PointLightBlock", POINT_LIGHT_BINDING },
+		{ "CameraBlock", CAMERA_BINDING },
+	};
+
+	for (const auto& [name, binding] : sharedBlocks)
+	{
+		uint32 index = glGetUniformBlockIndex(program, name);
+		if (index != GL_INVALID_INDEX)
+			glUniformBlockBinding(program, index, binding);
+	}
+
 	return program;
 }
\ No newline at end of file
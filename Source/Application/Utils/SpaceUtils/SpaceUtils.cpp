@@ -26,26 +26,24 @@ double RotationDegreeToLinearVelocity(float degreesPerSecond, float radiusMeters
     return (radiansPerSecond * radiusMeters) / METERS_PER_UNIT;
 }
 
-void InitializeCircularOrbit(EntityID satelliteID, EntityID attractorID, float32 inclination, bool isTidallyLocked) {
+void InitializeCircularOrbit(ECS& world, EntityID satelliteID, EntityID attractorID, float32 inclination, bool isTidallyLocked) {
     // Ensure required components
-    if (!ECS::Get().HasComponent<Transform>(satelliteID) ||
-        !ECS::Get().HasComponent<Transform>(attractorID) ||
-        !ECS::Get().HasComponent<Rigidbody>(satelliteID) ||
-        !ECS::Get().HasComponent<Rigidbody>(attractorID))
+    if (!world.HasComponents<Transform, Rigidbody>(satelliteID) ||
+        !world.HasComponents<Transform, Rigidbody>(attractorID))
     {
         spdlog::error("Missing required components to initialize orbit.");
         return;
     }
 
-    if (ECS::Get().HasComponent<Name>(satelliteID) &&
-        ECS::Get().HasComponent<Name>(attractorID))
+    if (world.HasComponent<Name>(satelliteID) &&
+        world.HasComponent<Name>(attractorID))
     {
-        const Name& satelliteName = *ECS::Get().GetComponent<Name>(satelliteID);
-        const Name& attractorName = *ECS::Get().GetComponent<Name>(attractorID);
+        const Name& satelliteName = *world.ReadComponent<Name>(satelliteID);
+        const Name& attractorName = *world.ReadComponent<Name>(attractorID);
 
         if (isTidallyLocked)
         {
-            ECS::Get().AddComponent(satelliteID, TidallyLocked{ attractorID });
+            world.AddComponent(satelliteID, TidallyLocked{ attractorID });
             spdlog::info("{} is set to be tidally locked around the orbit of {}", satelliteName.name, attractorName.name);
         }
         else
@@ -55,11 +53,11 @@ void InitializeCircularOrbit(EntityID satelliteID, EntityID attractorID, float32
     }
 
 
-    auto& satellitePos = ECS::Get().GetComponent<Transform>(satelliteID)->position;
-    auto& attractorPos = ECS::Get().GetComponent<Transform>(attractorID)->position;
+    auto& satellitePos = world.GetComponent<Transform>(satelliteID)->position;
+    auto& attractorPos = world.GetComponent<Transform>(attractorID)->position;
 
-    auto& satelliteRig = *ECS::Get().GetComponent<Rigidbody>(satelliteID);
-    auto& attractorRig = *ECS::Get().GetComponent<Rigidbody>(attractorID);
+    auto& satelliteRig = *world.GetComponent<Rigidbody>(satelliteID);
+    auto& attractorRig = *world.GetComponent<Rigidbody>(attractorID);
 
     Math::Vec3f direction = glm::normalize(attractorPos.GetWorld() - satellitePos.GetWorld());
     float distanceMeters = glm::length(attractorPos.GetWorld() - satellitePos.GetWorld());
@@ -89,27 +87,92 @@ void InitializeCircularOrbit(EntityID satelliteID, EntityID attractorID, float32
     spdlog::info(" - Attractor vel = ({:.6f}, {:.6f}, {:.6f})", attractorDeltaVel.x, attractorDeltaVel.y, attractorDeltaVel.z);
 }
 
-void Attract(const EntityID& objID)
+bool OrbitalElementsToState(double mu, const OrbitalElements& elements, Math::Vec3d& position, Math::Vec3d& velocity)
 {
-	if (!ECS::Get().HasComponent<Rigidbody>(objID) || !ECS::Get().HasComponent<Transform>(objID))
+    if (elements.semiMajorAxis <= 0.0 || elements.eccentricity < 0.0 || elements.eccentricity >= 1.0)
+        return false;
+
+    double e = elements.eccentricity;
+    double p = elements.semiMajorAxis * (1.0 - e * e);
+    double nu = glm::radians(static_cast<double>(elements.trueAnomaly));
+    double r = p / (1.0 + e * std::cos(nu));
+
+    double cosO = std::cos(glm::radians(static_cast<double>(elements.ascendingNode)));
+    double sinO = std::sin(glm::radians(static_cast<double>(elements.ascendingNode)));
+    double cosI = std::cos(glm::radians(static_cast<double>(elements.inclination)));
+    double sinI = std::sin(glm::radians(static_cast<double>(elements.inclination)));
+    double cosW = std::cos(glm::radians(static_cast<double>(elements.argumentOfPeriapsis)));
+    double sinW = std::sin(glm::radians(static_cast<double>(elements.argumentOfPeriapsis)));
+
+    // Perifocal basis (P towards periapsis, Q 90 degrees ahead) rotated by node, inclination and periapsis
+    Math::Vec3d P(cosO * cosW - sinO * sinW * cosI, sinO * cosW + cosO * sinW * cosI, sinW * sinI);
+    Math::Vec3d Q(-cosO * sinW - sinO * cosW * cosI, -sinO * sinW + cosO * cosW * cosI, cosW * sinI);
+
+    double speed = std::sqrt(mu / p);
+    Math::Vec3d p3 = P * (r * std::cos(nu)) + Q * (r * std::sin(nu));
+    Math::Vec3d v3 = P * (-speed * std::sin(nu)) + Q * (speed * (e + std::cos(nu)));
+
+    // The reference plane is the simulation's XZ plane (Y up); prograde matches InitializeCircularOrbit
+    position = Math::Vec3d(p3.x, p3.z, -p3.y);
+    velocity = Math::Vec3d(v3.x, v3.z, -v3.y);
+    return true;
+}
+
+void InitializeKeplerianOrbit(ECS& world, EntityID satelliteID, EntityID attractorID, const OrbitalElements& elements)
+{
+    if (!world.HasComponents<Transform, Rigidbody>(satelliteID) ||
+        !world.HasComponents<Transform, Rigidbody>(attractorID))
+    {
+        spdlog::error("Missing required components to initialize orbit.");
+        return;
+    }
+
+    auto& satelliteTransform = *world.GetComponent<Transform>(satelliteID);
+    const auto& attractorTransform = *world.ReadComponent<Transform>(attractorID);
+
+    auto& satelliteRig = *world.GetComponent<Rigidbody>(satelliteID);
+    auto& attractorRig = *world.GetComponent<Rigidbody>(attractorID);
+
+    Math::Vec3d position, velocity;
+    if (!OrbitalElementsToState(G * (attractorRig.mass + satelliteRig.mass), elements, position, velocity))
+    {
+        spdlog::error("Only closed orbits are supported (a > 0, 0 <= e < 1).");
+        return;
+    }
+
+    Math::Vec3f satelliteVel(velocity);
+
+    satelliteTransform.position.SetWorld(attractorTransform.position.GetWorld() + Math::Vec3f(position));
+    satelliteRig.velocity.SetWorld(attractorRig.velocity.GetWorld() + satelliteVel);
+
+    // Conservation of momentum: Apply opposite to attractor
+    Math::Vec3f momentum = satelliteVel * static_cast<float>(satelliteRig.mass);
+    Math::Vec3f attractorDeltaVel = -momentum / static_cast<float>(attractorRig.mass);
+    attractorRig.velocity.SetWorld(attractorRig.velocity.GetWorld() + attractorDeltaVel);
+}
+
+void Attract(ECS& world, const EntityID& objID)
+{
+	if (!world.HasComponents<Rigidbody, Transform>(objID))
 		return;
 
-    auto sphereIDs = ECS::Get().GetAllComponentIDs<Sphere>();
+    // Pools are stable while systems run; structural changes go through command buffers
+    const auto& bodyIDs = world.GetAllComponentIDs<Rigidbody>();
 
-	for (size_t i = 0; i < sphereIDs.size(); ++i)
+	for (size_t i = 0; i < bodyIDs.size(); ++i)
 	{
-        const EntityID& id = sphereIDs[i];
+        const EntityID& id = bodyIDs[i];
 		if (objID == id)
 			continue;
 
-        if (!ECS::Get().HasComponent<Rigidbody>(id) || !ECS::Get().HasComponent<Transform>(id))
+        if (!world.HasComponents<Rigidbody, Transform>(id))
             continue;
 
-        auto& objTransform  = *ECS::Get().GetComponent<Transform>(objID);
-        auto& objRigidbody  = *ECS::Get().GetComponent<Rigidbody>(objID);
+        auto& objTransform  = *world.GetComponent<Transform>(objID);
+        auto& objRigidbody  = *world.GetComponent<Rigidbody>(objID);
 
-		auto& obj2Transform  = *ECS::Get().GetComponent<Transform>(id);
-		auto& obj2Rigidbody  = *ECS::Get().GetComponent<Rigidbody>(id);
+		const auto& obj2Transform  = *world.ReadComponent<Transform>(id);
+		auto& obj2Rigidbody  = *world.GetComponent<Rigidbody>(id);
 
 		double dx = objTransform.position.GetWorld().x - obj2Transform.position.GetWorld().x;
 		double dy = objTransform.position.GetWorld().y - obj2Transform.position.GetWorld().y;
@@ -129,9 +192,9 @@ void Attract(const EntityID& objID)
         obj2Rigidbody.velocity.Accelerate(attraction);
 
         // If object is tidally locked to another object
-        if (ECS::Get().HasComponent<TidallyLocked>(objID))
+        if (world.HasComponent<TidallyLocked>(objID))
         {
-            const auto& lockedEntityId = ECS::Get().GetComponent<TidallyLocked>(objID)->lockedEntity;
+            const auto& lockedEntityId = world.ReadComponent<TidallyLocked>(objID)->lockedEntity;
 
             if (lockedEntityId == id)
                 ApplyTidalLock(objTransform, obj2Transform, objRigidbody);
@@ -141,7 +204,7 @@ void Attract(const EntityID& objID)
 }
 
 // Make Ta tidally locked towards Tb
-void ApplyTidalLock(Transform& Ta, Transform& Tb, Rigidbody& Ra)
+void ApplyTidalLock(Transform& Ta, const Transform& Tb, Rigidbody& Ra)
 {
     const Math::Vec3f& Pa = Ta.position.GetWorld();
     const Math::Vec3f& Pb = Tb.position.GetWorld();
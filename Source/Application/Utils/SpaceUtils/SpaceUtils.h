@@ -11,8 +11,25 @@ double CalculateOrbitalVelocity(double otherMass, double r);
 
 double RotationDegreeToLinearVelocity(float degreesPerSecond, float radiusMeters);
 
-void InitializeCircularOrbit(EntityID satelliteID, EntityID attractorID, float32 inclination, bool isTidallyLocked = false);
+// Classical Keplerian elements; distances in meters, angles in degrees
+struct OrbitalElements
+{
+    float64 semiMajorAxis = 0.0;
+    float64 eccentricity = 0.0;
+    float32 inclination = 0.0f;
+    float32 ascendingNode = 0.0f;
+    float32 argumentOfPeriapsis = 0.0f;
+    float32 trueAnomaly = 0.0f;
+};
 
-void Attract(const EntityID& objID);
+void InitializeCircularOrbit(ECS& world, EntityID satelliteID, EntityID attractorID, float32 inclination, bool isTidallyLocked = false);
 
-void ApplyTidalLock(Transform& Ta, Transform& Tb, Rigidbody& Ra);
\ No newline at end of file
+// Position and velocity relative to the attractor, in the simulation frame (XZ reference plane, Y up)
+bool OrbitalElementsToState(double mu, const OrbitalElements& elements, Math::Vec3d& position, Math::Vec3d& velocity);
+
+// Places the satellite on the given orbit relative to the attractor's current state
+void InitializeKeplerianOrbit(ECS& world, EntityID satelliteID, EntityID attractorID, const OrbitalElements& elements);
+
+void Attract(ECS& world, const EntityID& objID);
+
+void ApplyTidalLock(Transform& Ta, const Transform& Tb, Rigidbody& Ra);
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "StatsUtils.h"
+
+#include <spdlog/fmt/fmt.h>
+
+namespace Nyx
+{
+	String FormatBytes(usize bytes)
+	{
+		if (bytes < 1024)
+			return fmt::format("{} B", bytes);
+		if (bytes < 1024 * 1024)
+			return fmt::format("{:.1f} KiB", bytes / 1024.0);
+		return fmt::format("{:.1f} MiB", bytes / (1024.0 * 1024.0));
+	}
+
+	String FormatWorldStats(const WorldStats& stats)
+	{
+		const EntityStats& entities = stats.entities;
+
+		String out = fmt::format("ECS: {} alive, next ID {}, free list {} ({} runs), signatures {}, total {}\n",
+			entities.alive, entities.nextID, entities.freeListSize, entities.freeListRuns,
+			FormatBytes(stats.signatureBytes), FormatBytes(stats.totalBytes));
+
+		out += fmt::format("  {:<16} {:>10} {:>10} {:>12} {:>12} {:>10} {:>12} {:>8}\n",
+			"Pool", "Count", "Capacity", "Used", "Reserved", "Sparse", "Sparse mem", "Fill");
+
+		for (const PoolStats& pool : stats.pools)
+		{
+			// Fraction of the sparse table that points at a component
+			float64 fill = pool.sparseSize > 0 ? 100.0 * pool.count / pool.sparseSize : 0.0;
+
+			out += fmt::format("  {:<16} {:>10} {:>10} {:>12} {:>12} {:>10} {:>12} {:>7.1f}%\n",
+				pool.name, pool.count, pool.capacity, FormatBytes(pool.bytesUsed), FormatBytes(pool.bytesReserved),
+				pool.sparseSize, FormatBytes(pool.sparseBytes), fill);
+		}
+
+		return out;
+	}
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <Application/Core/Core.h>
+#include <Application/Core/Services/Managers/EntityManager/EntityManager.h>
+
+namespace Nyx
+{
+	// Plain-text table of a world's pools and entity allocator, for logs and headless runs
+	String FormatWorldStats(const WorldStats& stats);
+
+	String FormatBytes(usize bytes);
+}
@@ -8,7 +8,8 @@ namespace Nyx
 {
 	TextureData TextureLoader::Load(const String& path, bool flipVertically)
 	{
-		stbi_set_flip_vertically_on_load(flipVertically);
+		// Per-thread flag so scene loading can decode several images at once
+		stbi_set_flip_vertically_on_load_thread(flipVertically);
 
 		TextureData img{};
 
@@ -10,6 +10,8 @@
 #include <Application/Resource/Components/Components.h>
 #include <Application/Core/Services/Managers/EntityManager/EntityManager.h>
 #include <Application/Core/Services/CameraService/CameraService.h>
+#include <Application/Core/Services/Editor/Editor.h>
+#include <Application/Core/Services/Input/InputRecorder.h>
 
 namespace Nyx
 {
@@ -20,6 +22,49 @@ namespace Nyx
     float lastX = 400.0f;
     float lastY = 400.f;
 
+    static InputRecord MakeRecord(InputRecordType type, int32 a, int32 b = 0, int32 c = 0, float64 x = 0.0, float64 y = 0.0)
+    {
+        InputRecord record;
+        record.type = type;
+        record.args[0] = a;
+        record.args[1] = b;
+        record.args[2] = c;
+        record.values[0] = x;
+        record.values[1] = y;
+        return record;
+    }
+
+    // During a replay the recorded presses stand in for the keyboard
+    static bool8 IsKeyDown(int32 key)
+    {
+        const InputRecorder& recorder = InputRecorder::Get();
+        if (recorder.IsReplaying())
+            return recorder.IsKeyDown(key);
+
+        return glfwGetKey(gWindow, key) == GLFW_PRESS;
+    }
+
+    static void ReplayInput(const InputRecord& record)
+    {
+        switch (record.type)
+        {
+        case InputRecordType::MOUSE_BUTTON:
+            InputCallbacks::MouseButtonCallback(gWindow, record.args[0], record.args[1], record.args[2]);
+            break;
+        case InputRecordType::CURSOR_POS:
+            InputCallbacks::CursorPosCallback(gWindow, record.values[0], record.values[1]);
+            break;
+        case InputRecordType::KEY:
+            InputCallbacks::KeyboardCallback(gWindow, record.args[0], 0, record.args[1], record.args[2]);
+            break;
+        case InputRecordType::SCROLL:
+            InputCallbacks::ScrollCallback(gWindow, record.values[0], record.values[1]);
+            break;
+        default:
+            break;
+        }
+    }
+
     void InputHelper::SetMouseMode(MouseMode mode)
     {
         if (gWindow == nullptr)
@@ -71,14 +116,18 @@ namespace Nyx
 
         InputEventDispatcher::Get().AddCallback(EventType::MOUSE_MOVE, [&](const InputEvent& event)
         {
-            auto& cameraIDs = ECS::Get().GetAllComponentIDs<Camera>();
+            ECS* world = Editor::Get().activeWorld;
+            if (world == nullptr)
+                return;
+
+            Vector<EntityID> cameraIDs = world->View<Camera>();
 
             if (cameraIDs.size() <= 0)
                 return;
 
             const EntityID& id = cameraIDs[0];
 
-            auto& camera = *ECS::Get().GetComponent<Camera>(id);
+            auto& camera = *world->GetComponent<Camera>(id);
 
             if (GetMouseMode() != MouseMode::HIDDEN)
                 return;
@@ -128,14 +177,18 @@ namespace Nyx
     {
         InputEventDispatcher::Get().AddCallback(EventType::MOUSE_SCROLL_WHEEL, [&](const InputEvent& event)
         {
-            auto& cameraIDs = ECS::Get().GetAllComponentIDs<Camera>();
+            ECS* world = Editor::Get().activeWorld;
+            if (world == nullptr)
+                return;
+
+            Vector<EntityID> cameraIDs = world->View<Camera>();
 
             if (cameraIDs.size() <= 0)
                 return;
 
             const EntityID& id = cameraIDs[0];
 
-            auto& camera = *ECS::Get().GetComponent<Camera>(id);
+            auto& camera = *world->GetComponent<Camera>(id);
 
             if (GetMouseMode() != MouseMode::HIDDEN)
                 return;
@@ -163,6 +216,9 @@ namespace Nyx
 
     void InputCallbacks::MouseButtonCallback(GLFWwindow* window, int32 button, int32 action, int32 mods)
     {
+        if (!InputRecorder::Get().Accept(MakeRecord(InputRecordType::MOUSE_BUTTON, button, action, mods)))
+            return;
+
         InputQueue* queue = static_cast<InputQueue*>(glfwGetWindowUserPointer(gWindow));
 
         if (action == GLFW_PRESS)
@@ -192,6 +248,9 @@ namespace Nyx
 
     void InputCallbacks::CursorPosCallback(GLFWwindow* window, float64 xPos, float64 yPos)
     {
+        if (!InputRecorder::Get().Accept(MakeRecord(InputRecordType::CURSOR_POS, 0, 0, 0, xPos, yPos)))
+            return;
+
         InputQueue* queue = static_cast<InputQueue*>(glfwGetWindowUserPointer(window));
         InputEvent localEvent;
 
@@ -211,6 +270,9 @@ namespace Nyx
 
     void InputCallbacks::KeyboardCallback(GLFWwindow* window, int32 key, int32 scanCode, int32 action, int32 mods) 
     {
+        if (!InputRecorder::Get().Accept(MakeRecord(InputRecordType::KEY, key, action, mods)))
+            return;
+
         InputQueue* queue = static_cast<InputQueue*>(glfwGetWindowUserPointer(window));
         InputEvent localEvent;
 
@@ -234,6 +296,9 @@ namespace Nyx
 
     void InputCallbacks::ScrollCallback(GLFWwindow* window, double xOffset, double yOffset)
     {
+        if (!InputRecorder::Get().Accept(MakeRecord(InputRecordType::SCROLL, 0, 0, 0, xOffset, yOffset)))
+            return;
+
         InputQueue* queue = static_cast<InputQueue*>(glfwGetWindowUserPointer(window));
         InputEvent localEvent;
 
@@ -279,6 +344,7 @@ namespace Nyx
         glfwSetCursorPosCallback(gWindow, InputCallbacks::CursorPosCallback);
         glfwSetKeyCallback(gWindow, InputCallbacks::KeyboardCallback);
         glfwSetScrollCallback(gWindow, InputCallbacks::ScrollCallback);
+        InputRecorder::Get().SetSink(ReplayInput);
 
         glewExperimental = GL_TRUE;
         glewInit();
@@ -302,6 +368,9 @@ namespace Nyx
     {
         ProcessKeyboard();
         glfwPollEvents();
+
+        // Everything polled so far belongs to this frame
+        InputRecorder::Get().EndFrame();
     }
 
     void BasicWindow::SwapBuffers()
@@ -332,33 +401,37 @@ namespace Nyx
         if (gWindow == nullptr)
             return;
 
-        auto& cameraIDs = ECS::Get().GetAllComponentIDs<Camera>();
+        ECS* world = Editor::Get().activeWorld;
+        if (world == nullptr)
+            return;
+
+        Vector<EntityID> cameraIDs = world->View<Camera>();
 
         if (cameraIDs.size() <= 0)
             return;
 
         const EntityID& id = cameraIDs[0];
-        auto& camera = *ECS::Get().GetComponent<Camera>(id);
+        auto& camera = *world->GetComponent<Camera>(id);
 
         float effectiveDelta = DELTA_TIME;
-        if (glfwGetKey(gWindow, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)
+        if (IsKeyDown(GLFW_KEY_LEFT_SHIFT))
             effectiveDelta *= camera.GetMovementSpeedMultiplier();
 
-        if (glfwGetKey(gWindow, GLFW_KEY_LEFT_ALT) == GLFW_PRESS)
+        if (IsKeyDown(GLFW_KEY_LEFT_ALT))
             effectiveDelta /= camera.GetMovementSpeedMultiplier();
 
-        if (glfwGetKey(gWindow, GLFW_KEY_W) == GLFW_PRESS)
-            camera.ProcessKeyboardMovement(FORWARD, effectiveDelta);
-        if (glfwGetKey(gWindow, GLFW_KEY_S) == GLFW_PRESS)
-            camera.ProcessKeyboardMovement(BACKWARD, effectiveDelta);
-        if (glfwGetKey(gWindow, GLFW_KEY_A) == GLFW_PRESS)
-            camera.ProcessKeyboardMovement(LEFT, effectiveDelta);
-        if (glfwGetKey(gWindow, GLFW_KEY_D) == GLFW_PRESS)
-            camera.ProcessKeyboardMovement(RIGHT, effectiveDelta);
-        if (glfwGetKey(gWindow, GLFW_KEY_SPACE) == GLFW_PRESS)
-            camera.ProcessKeyboardMovement(UP, effectiveDelta);
-        if (glfwGetKey(gWindow, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS)
-            camera.ProcessKeyboardMovement(DOWN, effectiveDelta);
+        if (IsKeyDown(GLFW_KEY_W))
+            camera.ProcessKeyboardMovement(*world, id, FORWARD, effectiveDelta);
+        if (IsKeyDown(GLFW_KEY_S))
+            camera.ProcessKeyboardMovement(*world, id, BACKWARD, effectiveDelta);
+        if (IsKeyDown(GLFW_KEY_A))
+            camera.ProcessKeyboardMovement(*world, id, LEFT, effectiveDelta);
+        if (IsKeyDown(GLFW_KEY_D))
+            camera.ProcessKeyboardMovement(*world, id, RIGHT, effectiveDelta);
+        if (IsKeyDown(GLFW_KEY_SPACE))
+            camera.ProcessKeyboardMovement(*world, id, UP, effectiveDelta);
+        if (IsKeyDown(GLFW_KEY_LEFT_CONTROL))
+            camera.ProcessKeyboardMovement(*world, id, DOWN, effectiveDelta);
     }
 
     void* BasicWindow::GetHandle()
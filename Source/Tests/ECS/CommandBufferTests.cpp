@@ -0,0 +1,73 @@
+#include <Tests/Test.h>
+
+#include <Application/Core/Services/Managers/EntityManager/EntityManager.h>
+
+using namespace Nyx;
+
+namespace
+{
+	struct Health
+	{
+		int32 value;
+	};
+
+	// Remove then Add in one flush replaces the component rather than losing it
+	void ReplaceComponentInOneFlush()
+	{
+		ECS world;
+		EntityID entity = world.CreateEntity();
+		world.AddComponent(entity, Health{ 1 });
+
+		world.BeginDeferred();
+		CommandBuffer& commands = world.GetCommandBuffer();
+		commands.RemoveComponent<Health>(entity);
+		commands.AddComponent(entity, Health{ 2 });
+		world.EndDeferred();
+
+		NYX_CHECK(world.HasComponent<Health>(entity));
+		NYX_CHECK(world.GetComponentCount<Health>() == 1);
+		if (world.HasComponent<Health>(entity))
+			NYX_CHECK(world.ReadComponent<Health>(entity)->value == 2);
+	}
+
+	// Add then Remove in one flush leaves the entity without the component
+	void AddThenRemoveInOneFlush()
+	{
+		ECS world;
+		EntityID entity = world.CreateEntity();
+
+		world.BeginDeferred();
+		CommandBuffer& commands = world.GetCommandBuffer();
+		commands.AddComponent(entity, Health{ 3 });
+		commands.RemoveComponent<Health>(entity);
+		world.EndDeferred();
+
+		NYX_CHECK(!world.HasComponent<Health>(entity));
+		NYX_CHECK(world.GetComponentCount<Health>() == 0);
+	}
+
+	// A deferred entity can be given components in the same flush that creates it
+	void CreateThenAddInOneFlush()
+	{
+		ECS world;
+
+		world.BeginDeferred();
+		CommandBuffer& commands = world.GetCommandBuffer();
+		EntityID entity = commands.CreateEntity();
+		commands.AddComponent(entity, Health{ 4 });
+		world.EndDeferred();
+
+		NYX_CHECK(world.HasComponent<Health>(entity));
+		if (world.HasComponent<Health>(entity))
+			NYX_CHECK(world.ReadComponent<Health>(entity)->value == 4);
+	}
+}
+
+int main()
+{
+	ReplaceComponentInOneFlush();
+	AddThenRemoveInOneFlush();
+	CreateThenAddInOneFlush();
+
+	return NYX_TEST_RESULT();
+}
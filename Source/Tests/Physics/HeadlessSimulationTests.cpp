@@ -0,0 +1,85 @@
+#include <Tests/Test.h>
+
+#include <Application/Constants/Constants.h>
+#include <Application/Core/Physics/Physics.h>
+#include <Application/Core/Services/Managers/SceneManager/SceneManager.h>
+
+using namespace Nyx;
+
+namespace
+{
+	// A sun, a planet on a circular orbit and a small massless belt; no textures
+	constexpr const char8* SCENE = R"(
+body Sun
+    mass 1.989e30
+    radius 6.96e8
+end
+
+body Earth
+    mass 5.972e24
+    radius 6.371e6
+    orbit Sun 1.496e11
+end
+
+belt Belt
+    attractor Sun
+    count 16
+    seed 7
+    semimajor uniform 3.0e11 4.0e11
+    mass 1.0e15
+    radius 1.0e4
+end
+)";
+
+	String WriteScene()
+	{
+		FileSystem::path path = FileSystem::temp_directory_path() / "NyxHeadlessSimulation.nyxscene";
+		OfStream out(path, std::ios::trunc);
+		out << SCENE;
+		return path.string();
+	}
+
+	// Bodies loaded without graphics have no Sphere, and must still be simulated
+	void HeadlessBodiesMove()
+	{
+		SceneManager sceneManager;
+		SceneID sceneID = sceneManager.CreateScene();
+		NYX_CHECK(sceneManager.LoadScene(sceneID, WriteScene(), false));
+
+		ECS& world = sceneManager.GetActiveScene()->GetWorld();
+		NYX_CHECK(world.GetComponentCount<Sphere>() == 0);
+
+		Vector<EntityID> bodies = world.View<Transform, Rigidbody>();
+		NYX_CHECK(bodies.size() == 18);
+
+		Vector<Math::Vec3f> positions;
+		Vector<Math::Vec3f> velocities;
+		for (EntityID id : bodies)
+		{
+			positions.push_back(world.ReadComponent<Transform>(id)->position.GetWorld());
+			velocities.push_back(world.ReadComponent<Rigidbody>(id)->velocity.GetWorld());
+		}
+
+		for (uint32 frame = 0; frame < 60; ++frame)
+			Physics::Update(world, DELTA_TIME);
+
+		for (usize i = 0; i < bodies.size(); ++i)
+		{
+			const Transform& transform = *world.ReadComponent<Transform>(bodies[i]);
+			const Rigidbody& rigidbody = *world.ReadComponent<Rigidbody>(bodies[i]);
+
+			// Everything but the sun starts moving; gravity then bends every path, the sun's included
+			if (world.HasComponent<Name>(bodies[i]) && world.ReadComponent<Name>(bodies[i])->name == "Sun")
+				NYX_CHECK(rigidbody.velocity.GetWorld() != velocities[i]);
+			else
+				NYX_CHECK(transform.position.GetWorld() != positions[i]);
+		}
+	}
+}
+
+int main()
+{
+	HeadlessBodiesMove();
+
+	return NYX_TEST_RESULT();
+}
@@ -0,0 +1,69 @@
+#include <Tests/Test.h>
+
+#include <Application/Core/Renderer/RenderQueue.h>
+
+using namespace Nyx;
+
+namespace
+{
+	constexpr float32 NEAR_PLANE = 0.1f;
+	constexpr float32 FAR_PLANE = 3.0e6f;
+
+	uint64 Key(RenderPass pass, float32 depth)
+	{
+		return RenderQueue::MakeKey(pass, 1, 2, 3, depth, NEAR_PLANE, FAR_PLANE);
+	}
+
+	// Solid sorts front to back, including at and beyond the far plane
+	void SolidDepthOrder()
+	{
+		NYX_CHECK(Key(RenderPass::SOLID, NEAR_PLANE) < Key(RenderPass::SOLID, 1.0f));
+		NYX_CHECK(Key(RenderPass::SOLID, 1.0f) < Key(RenderPass::SOLID, FAR_PLANE * 0.5f));
+		NYX_CHECK(Key(RenderPass::SOLID, NEAR_PLANE) < Key(RenderPass::SOLID, FAR_PLANE));
+		NYX_CHECK(Key(RenderPass::SOLID, FAR_PLANE * 0.5f) < Key(RenderPass::SOLID, FAR_PLANE));
+		NYX_CHECK(Key(RenderPass::SOLID, FAR_PLANE) == Key(RenderPass::SOLID, FAR_PLANE * 2.0f));
+	}
+
+	// Blended sorts back to front
+	void BlendedDepthOrder()
+	{
+		NYX_CHECK(Key(RenderPass::BLENDED, FAR_PLANE) < Key(RenderPass::BLENDED, NEAR_PLANE));
+		NYX_CHECK(Key(RenderPass::BLENDED, FAR_PLANE) < Key(RenderPass::BLENDED, FAR_PLANE * 0.5f));
+		NYX_CHECK(Key(RenderPass::BLENDED, 1.0f) < Key(RenderPass::BLENDED, NEAR_PLANE));
+	}
+
+	// Depth stays in its own bits, so no depth can move a key into another pass or state group
+	void DepthStaysInItsField()
+	{
+		NYX_CHECK(Key(RenderPass::SOLID, FAR_PLANE) < Key(RenderPass::BLENDED, FAR_PLANE));
+		NYX_CHECK(Key(RenderPass::SOLID, FAR_PLANE) < RenderQueue::MakeKey(RenderPass::SOLID, 1, 2, 4, NEAR_PLANE, NEAR_PLANE, FAR_PLANE));
+	}
+
+	void SortOrdersByKey()
+	{
+		RenderQueue queue;
+		queue.Push(Key(RenderPass::SOLID, FAR_PLANE), 0);
+		queue.Push(Key(RenderPass::SOLID, NEAR_PLANE), 1);
+		queue.Push(Key(RenderPass::SOLID, 1.0f), 2);
+		queue.Sort();
+
+		const Vector<RenderQueue::Item>& items = queue.GetItems();
+		NYX_CHECK(items.size() == 3);
+		if (items.size() == 3)
+		{
+			NYX_CHECK(items[0].index == 1);
+			NYX_CHECK(items[1].index == 2);
+			NYX_CHECK(items[2].index == 0);
+		}
+	}
+}
+
+int main()
+{
+	SolidDepthOrder();
+	BlendedDepthOrder();
+	DepthStaysInItsField();
+	SortOrdersByKey();
+
+	return NYX_TEST_RESULT();
+}
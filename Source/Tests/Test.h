@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdio>
+
+// Tests are plain executables registered with CTest; a failed check is reported and turns
+// into a non-zero exit code, so no framework is needed
+namespace Nyx::Test
+{
+	inline int& Failures()
+	{
+		static int failures = 0;
+		return failures;
+	}
+}
+
+#define NYX_CHECK(condition)                                                           \
+	do                                                                                 \
+	{                                                                                  \
+		if (!(condition))                                                              \
+		{                                                                              \
+			std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			++Nyx::Test::Failures();                                                   \
+		}                                                                              \
+	} while (false)
+
+#define NYX_TEST_RESULT() (Nyx::Test::Failures() == 0 ? 0 : 1)